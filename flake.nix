@@ -49,6 +49,9 @@
               gepetto-viewer = pkgs.gepetto-viewer.overrideAttrs override;
               py-gepetto-viewer = pkgs.python3Packages.gepetto-viewer.overrideAttrs override;
             };
+          # Build the Qt interface, including the property editors, on each
+          # check.
+          checks.qt-build = self'.packages.gepetto-viewer;
         };
     };
 }
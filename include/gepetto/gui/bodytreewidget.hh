@@ -19,6 +19,7 @@
 
 #include <gepetto/gui/fwd.hh>
 // This include must be include before any other Qt include for GLDEBUGPROC
+#include <QPointer>
 #include <QStandardItemModel>
 #include <QToolBox>
 #include <QTreeView>
@@ -32,7 +33,8 @@ class BodyTreeWidget : public QWidget {
   Q_OBJECT
 
  public:
-  explicit BodyTreeWidget(QWidget* parent = NULL) : QWidget(parent) {}
+  explicit BodyTreeWidget(QWidget* parent = NULL)
+      : QWidget(parent), propertyAreaUpdatePending_(false) {}
 
   /// Init the widget.
   /// \param view tree view to display.
@@ -66,6 +68,11 @@ class BodyTreeWidget : public QWidget {
   /// Get selected bodies
   QList<BodyTreeItem*> selectedBodies() const;
 
+  /// Compute the memory used by each body and display it in a second
+  /// column.
+  /// \sa viewer::MemoryUsageVisitor
+  void showMemoryUsage();
+
   /// \}
 
  protected slots:
@@ -75,6 +82,9 @@ class BodyTreeWidget : public QWidget {
 
   void currentChanged(const QModelIndex& current, const QModelIndex& previous);
 
+  /// Show the editors of propertyItem_ in the property area.
+  void doUpdatePropertyArea();
+
  private:
   /// Handle a selection event
   ///
@@ -82,12 +92,16 @@ class BodyTreeWidget : public QWidget {
   /// is updated.
   void handleSelectionEvent(const SelectionEvent* event);
 
+  /// Show the editors of an item once control returns to the event loop,
+  /// so that a burst of selection changes updates the area once.
   void updatePropertyArea(BodyTreeItem* item);
 
   QTreeView* view_;
   QStandardItemModel* model_;
   WindowsManagerPtr_t osg_;
   QWidget* propertyArea_;
+  QPointer<BodyTreeItem> propertyItem_;
+  bool propertyAreaUpdatePending_;
 };
 }  // namespace gui
 }  // namespace gepetto
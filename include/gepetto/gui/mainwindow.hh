@@ -84,7 +84,11 @@ class MainWindow : public QMainWindow {
 
 #if GEPETTO_GUI_HAS_PYTHONQT
   /// Get the python widget.
-  PythonWidget* pythonWidget() { return pythonWidget_; }
+  /// The Python interpreter is initialized on the first call.
+  PythonWidget* pythonWidget();
+
+  /// Whether the Python interpreter is initialized.
+  bool hasPythonWidget() const { return pythonWidget_ != NULL; }
 #endif
 
  signals:
@@ -214,10 +218,19 @@ class MainWindow : public QMainWindow {
   void closeConnection();
   void about();
 
+  /// Load the plugins when Settings::deferPlugins is true.
+  void loadPlugins();
+#if GEPETTO_GUI_HAS_PYTHONQT
+  void showPythonWidget();
+#endif
+
  private:
   void splitTabifiedDockWidget(Qt::Orientation orientation);
   void setupInterface();
   void createCentralWidget();
+#if GEPETTO_GUI_HAS_PYTHONQT
+  void createPythonWidget();
+#endif
 
   static MainWindow* instance_;
 
@@ -226,6 +239,8 @@ class MainWindow : public QMainWindow {
   QList<OSGWidget*> osgWindows_;
 #if GEPETTO_GUI_HAS_PYTHONQT
   PythonWidget* pythonWidget_;
+  /// Action creating the Python console, when Python is not initialized.
+  QAction* pythonConsoleAction_;
 #endif
   ShortcutFactory* shortcutFactory_;
   SelectionHandler* selectionHandler_;
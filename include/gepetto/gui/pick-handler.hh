@@ -62,11 +62,15 @@ class PickHandler : public osgGA::GUIEventHandler {
 
   void setCameraToSelected(osgGA::GUIActionAdapter& aa, bool zoom);
 
+  /// Highlight the node under the cursor, when the window uses id picking.
+  void hover(const float& x, const float& y);
+
   QtOsgKeyboard mapper_;
   WindowsManagerPtr_t wsm_;
   OSGWidget* parent_;
   bool pushed_;
   float lastX_, lastY_;
+  viewer::NodeWeakPtr hovered_;
 
   LineSegmentIntersector lineIntersector_;
   osg::ref_ptr<PointIntersector> pointIntersector_;
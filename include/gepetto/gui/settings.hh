@@ -17,6 +17,7 @@
 #ifndef GEPETTO_GUI_SETTINGS_HH
 #define GEPETTO_GUI_SETTINGS_HH
 
+#include <QElapsedTimer>
 #include <QString>
 #include <QStringList>
 #include <gepetto/gui/dialog/pluginmanagerdialog.hh>
@@ -45,6 +46,11 @@ struct Settings {
   bool noPlugin;
   bool autoWriteSettings;
   bool useNameService;
+  /// Log the duration of each startup phase.
+  bool startupTrace;
+  /// Load the plugins once the main window is shown and initialize Python
+  /// when it is first needed.
+  bool deferPlugins;
 
   int refreshRate;
 
@@ -102,8 +108,21 @@ struct Settings {
 
   void setMainWindow(MainWindow* main);
 
+  /// Load the plugins, the Python plugins and run the Python scripts.
+  /// When Settings::deferPlugins is true, this is postponed until the event
+  /// loop is running.
   void initPlugins();
 
+  /// Load the plugins, the Python plugins and run the Python scripts now.
+  void loadPlugins();
+
+  /// Restore the history of the Python console, when it is created after
+  /// Settings::restoreState.
+  void restorePythonHistory() const;
+
+  /// Log the time since the beginning of the startup.
+  void traceStartupDone() const;
+
   std::ostream& print(std::ostream& os);
 
   /// \note Prefer using Settings::fromFiles()
@@ -153,6 +172,20 @@ struct Settings {
 
   MainWindow* mw;
   QStringList omniORBargv_;
+  QElapsedTimer startupTimer_;
+};
+
+/// Log the duration of a startup phase, from construction to destruction,
+/// when Settings::startupTrace is true.
+class StartupPhase {
+ public:
+  StartupPhase(const Settings* settings, const QString& name);
+  ~StartupPhase();
+
+ private:
+  const Settings* settings_;
+  QString name_;
+  QElapsedTimer timer_;
 };
 }  // namespace gui
 }  // namespace gepetto
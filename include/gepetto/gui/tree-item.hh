@@ -35,7 +35,6 @@ class BodyTreeItem : public QObject, public QStandardItem {
 
  public:
   BodyTreeItem(QObject* parent, NodePtr_t node);
-  void initialize();
 
   virtual QStandardItem* clone() const;
 
@@ -47,7 +46,9 @@ class BodyTreeItem : public QObject, public QStandardItem {
 
   void setParentGroup(const std::string& parent);
 
-  QWidget* propertyEditors() const { return propertyEditors_; }
+  /// The editors of the properties of the node, built on first use.
+  /// \note Must be called from the thread of the body tree.
+  QWidget* propertyEditors();
 
   virtual ~BodyTreeItem();
 
@@ -64,11 +65,6 @@ class BodyTreeItem : public QObject, public QStandardItem {
   void deleteLandmark();
   QString text() const { return QStandardItem::text(); }
 
- signals:
-  void requestInitialize();
- private slots:
-  void doInitialize();
-
  private:
   NodePtr_t node_;
   std::string parentGroup_;
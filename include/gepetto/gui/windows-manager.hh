@@ -43,9 +43,11 @@ class WindowsManager : public QObject, public viewer::WindowsManager {
   bool addToGroup(const std::string& nodeName, const std::string& groupName);
   bool removeFromGroup(const std::string& nodeName,
                        const std::string& groupName);
-  bool deleteNode(const std::string& nodeName, bool all);
 
-  BodyTreeItems_t bodyTreeItems(const std::string& name) const;
+  /// The items of the body tree showing a node.
+  /// \note Called from the thread of the body tree, the items created since
+  ///       the last event loop are inserted in the model first.
+  BodyTreeItems_t bodyTreeItems(const std::string& name);
 
   void captureFrame(const WindowID windowId, const std::string& filename);
   bool startCapture(const WindowID windowId, const std::string& filename,
@@ -58,6 +60,13 @@ class WindowsManager : public QObject, public viewer::WindowsManager {
  public slots:
   WindowID createWindow(QString windowName);
   void asyncRefresh();
+  /// Insert the body tree items created since the last call into the model,
+  /// with one insertion per parent, then take the items removed from their
+  /// group.
+  void appendPendingItems();
+  /// Delete the body tree items of the nodes deleted since the last call,
+  /// with one removal per range of rows.
+  void deletePendingItems();
 
  protected:
   WindowsManager(BodyTreeWidget* bodyTree);
@@ -66,24 +75,49 @@ class WindowsManager : public QObject, public viewer::WindowsManager {
                        GroupNodePtr_t parent);
   virtual void addGroup(const std::string& groupName, GroupNodePtr_t group,
                         GroupNodePtr_t parent);
+  virtual void nodesDeleted(const std::vector<std::string>& nodeNames);
 
  private:
   typedef std::pair<BodyTreeItems_t, bool> BodyTreeItemsAndGroup_t;
   typedef std::map<std::string, BodyTreeItemsAndGroup_t> BodyTreeItemMap_t;
   BodyTreeWidget* bodyTree_;
+  /// Locked before pendingItemsMtx_ when both are needed.
+  viewer::Mutex nodeItemMapMtx_;
   BodyTreeItemMap_t nodeItemMap_;
 
+  /// Both require nodeItemMapMtx_ to be locked.
   bool initParent(NodePtr_t node, GroupNodePtr_t parent, bool isGroup);
   void addToGroup(const std::string& nodeName, const std::string& groupName,
                   const NodePtr_t& node, const BodyTreeItems_t& groups,
                   bool isGroup);
-  void deleteBodyItem(const std::string& nodeName);
+
+  /// Append an item to a parent item, NULL for the root of the model.
+  /// Items whose parent is in the model, or may be inserted into it at the
+  /// same time, wait for appendPendingItems. The others are inserted
+  /// directly, which does not notify the model.
+  void appendItem(QStandardItem* parent, BodyTreeItem* item);
+  /// Remove an item from its parent item. Items in the model are taken in
+  /// the thread of the body tree, by appendPendingItems.
+  void takeItem(BodyTreeItem* item);
 
   std::map<WindowID, OSGWidget*> widgets_;
 
   bool refreshIsSynchronous_;
   viewer::Mutex configsAsyncMtx_;
   NodeConfigurations_t configsAsync_;
+
+  typedef std::vector<std::pair<QStandardItem*, BodyTreeItem*> >
+      PendingItems_t;
+  /// The model is not modified with this mutex locked, so that the nodes
+  /// can be added or deleted while the model is updated.
+  viewer::Mutex pendingItemsMtx_;
+  PendingItems_t pendingItems_;
+  /// Whether appendPendingItems is inserting items into the model.
+  bool appendingItems_;
+  /// Items removed from their group, waiting for appendPendingItems.
+  std::vector<BodyTreeItem*> takenItems_;
+  /// Items of the deleted nodes, waiting for deletePendingItems.
+  std::vector<BodyTreeItem*> deletedItems_;
 };
 }  // namespace gui
 }  // namespace gepetto
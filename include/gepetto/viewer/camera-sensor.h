@@ -0,0 +1,123 @@
+//
+//  camera-sensor.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_CAMERA_SENSOR_HH
+#define GEPETTO_VIEWER_CAMERA_SENSOR_HH
+
+#include <gepetto/viewer/config-osg.h>
+
+#include <boost/function.hpp>
+#include <osg/Image>
+#include <osg/Texture2D>
+#include <osg/Timer>
+
+namespace gepetto {
+namespace viewer {
+DEF_CLASS_SMART_PTR(CameraSensor)
+
+/// Synthetic RGB-D camera attached to a node of the scene of a window.
+///
+/// The sensor renders the visible nodes offscreen into a color image and a
+/// depth buffer. A second pass converts the depth buffer on the graphics card
+/// into a point cloud, expressed in the optical frame of the sensor: the z
+/// axis of the node is the optical axis, the x axis points to the right of
+/// the image and the y axis to its bottom.
+///
+/// The images are read back after each rendering of the sensor, in place, so
+/// that their data pointers remain valid as long as the sensor exists.
+/// Their rows start from the bottom of the image, as in OpenGL.
+///
+/// \sa WindowManager::addCameraSensor
+class CameraSensor {
+ public:
+  /// Called after each rendering of the sensor, in the rendering thread.
+  typedef boost::function<void(const CameraSensor&)> Callback_t;
+
+  /// \param fovy vertical field of view, in radians.
+  /// \param zNear, zFar range of the sensor, in meters. Points farther away
+  ///        are not measured.
+  /// \throw std::invalid_argument if the parameters are invalid.
+  static CameraSensorPtr_t create(const std::string& name,
+                                  const NodePtr_t& node,
+                                  const unsigned int& width,
+                                  const unsigned int& height,
+                                  const float& fovy, const float& zNear,
+                                  const float& zFar);
+
+  const std::string& getName() const { return name_; }
+
+  /// The node the sensor is attached to.
+  NodePtr_t getNode() const { return node_.lock(); }
+
+  unsigned int getWidth() const { return width_; }
+  unsigned int getHeight() const { return height_; }
+
+  /// Set the number of renderings per second. The sensor is rendered at most
+  /// once per frame of the window.
+  /// \param rate 0 to render the sensor at each frame of the window.
+  void setRate(const float& rate) { rate_ = rate; }
+  float getRate() const { return rate_; }
+
+  void setCallback(const Callback_t& callback) { callback_ = callback; }
+
+  /// Color image, in GL_RGBA and GL_UNSIGNED_BYTE.
+  const ::osg::Image* getColorImage() const { return color_image_.get(); }
+
+  /// Point cloud, in GL_RGBA and GL_FLOAT. Each pixel is the point (x, y, z)
+  /// seen by the sensor, where z is the metric depth, and a fourth component
+  /// equal to 1 where a point was measured and to 0 elsewhere.
+  const ::osg::Image* getPointImage() const { return point_image_.get(); }
+
+  /// Number of renderings since the creation of the sensor.
+  std::size_t getFrameCount() const { return frame_count_; }
+
+  ~CameraSensor();
+
+ protected:
+  CameraSensor(const std::string& name, const NodePtr_t& node,
+               const unsigned int& width, const unsigned int& height,
+               const float& fovy, const float& zNear, const float& zFar);
+
+ private:
+  std::string name_;
+  NodeWeakPtr node_;
+  unsigned int width_, height_;
+  float rate_;
+  Callback_t callback_;
+  std::size_t frame_count_;
+  ::osg::Timer_t last_tick_;
+  bool rendering_;
+
+  /** Root of the cameras, added to the window. */
+  ::osg::GroupRefPtr root_;
+  ::osg::CameraRefPtr color_camera_, point_camera_;
+  ::osg::ref_ptr< ::osg::Image> color_image_, point_image_;
+  ::osg::ref_ptr< ::osg::Texture2D> depth_texture_;
+  /** Root of the scene of the window, set when added to a window. */
+  ::osg::Group* scene_;
+
+  void createColorCamera(const float& fovy, const float& zNear,
+                         const float& zFar);
+  void createPointCamera(const float& fovy, const float& zNear,
+                         const float& zFar);
+
+  /// Render a scene, and return the node to add to the window.
+  ::osg::Group* setScene(::osg::Group* scene);
+
+  /// Decide whether the sensor is rendered in the next frame and place it
+  /// at the current pose of its node.
+  /// \return whether the sensor is rendered.
+  bool prepareFrame(const ::osg::Timer_t& tick);
+  /// Notify the callback when the sensor was rendered.
+  void frameDone();
+
+  friend class WindowManager;
+}; /* class CameraSensor */
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_CAMERA_SENSOR_HH */
@@ -0,0 +1,89 @@
+//
+//  frozen-geometry.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_FROZEN_GEOMETRY_HH
+#define GEPETTO_VIEWER_FROZEN_GEOMETRY_HH
+
+#include <gepetto/viewer/config-osg.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+namespace gepetto {
+namespace viewer {
+class FreezeVisitor;
+
+/// Triangles of several nodes sharing the same state set, merged into a
+/// single geometry and a single draw call.
+///
+/// The vertices are expressed in the frame of the frozen group. Each vertex
+/// and triangle remembers the name of the node it comes from, so that picking
+/// resolves the original node.
+class FrozenGeometry : public ::osg::Geometry {
+ public:
+  /// Name of the node which the triangle comes from.
+  /// \param index the primitive index of an intersection.
+  const std::string& nodeAtTriangle(unsigned int index) const;
+
+  /// Name of the node which the vertex comes from.
+  const std::string& nodeAtVertex(unsigned int index) const;
+
+  /// Merge the visible geometries of a set of subgraphs.
+  class Builder {
+   public:
+    /// Whether the visible geometries of a subgraph can be merged.
+    /// Subgraphs containing lines, points, text, cameras or transforms
+    /// depending on the view cannot.
+    static bool canFreeze(::osg::Node* root);
+
+    /// Add the visible geometries of a subgraph.
+    void add(::osg::Node* root);
+
+    /// The merged geometries.
+    ::osg::ref_ptr< ::osg::Geode> geode() const;
+
+   private:
+    std::vector< ::osg::ref_ptr<FrozenGeometry> > geometries_;
+
+    friend class FreezeVisitor;
+  };
+
+ private:
+  struct Range {
+    unsigned int firstVertex, firstTriangle;
+    std::string node;
+  };
+  /// Sorted by increasing vertex and triangle indices.
+  std::vector<Range> ranges_;
+
+  static bool beforeTriangle(unsigned int index, const Range& range) {
+    return index < range.firstTriangle;
+  }
+  static bool beforeVertex(unsigned int index, const Range& range) {
+    return index < range.firstVertex;
+  }
+
+  ::osg::ref_ptr< ::osg::Vec3Array> vertices_, normals_;
+  ::osg::ref_ptr< ::osg::Vec4Array> colors_;
+  ::osg::ref_ptr< ::osg::Vec2Array> texCoords_;
+  ::osg::ref_ptr< ::osg::DrawElementsUInt> triangles_;
+
+  FrozenGeometry(::osg::StateSet* stateSet, bool normals, bool colors,
+                 bool texCoords);
+
+  bool accepts(const ::osg::StateSet* stateSet, bool normals, bool colors,
+               bool texCoords) const;
+
+  void add(const ::osg::Geometry& geom, const ::osg::Matrix& matrix,
+           const std::string& node);
+
+  friend class FreezeVisitor;
+};
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_FROZEN_GEOMETRY_HH */
@@ -15,6 +15,7 @@ namespace gepetto {
 namespace viewer {
 
 struct Configuration;
+struct CullingStatistics;
 DEF_CLASS_SMART_PTR(Node)
 DEF_CLASS_SMART_PTR(GroupNode)
 
@@ -22,6 +23,7 @@ DEF_CLASS_SMART_PTR(Property)
 
 DEF_CLASS_SMART_PTR(WindowManager)
 DEF_CLASS_SMART_PTR(RoadmapViewer)
+DEF_CLASS_SMART_PTR(CameraSensor)
 
 typedef std::string WindowID;
 } /* namespace viewer */
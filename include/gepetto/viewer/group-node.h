@@ -11,6 +11,10 @@
 
 #include <gepetto/viewer/node.h>
 
+#include <osg/Geode>
+#include <set>
+#include <unordered_map>
+
 namespace gepetto {
 namespace viewer {
 
@@ -23,10 +27,34 @@ class GroupNode : public Node {
    */
   typedef std::vector<NodePtr_t> Nodes_t;
   Nodes_t list_of_objects_;
+  /** Positions of the occurrences of each child in list_of_objects_ */
+  typedef std::unordered_map<const Node*, std::vector<std::size_t> >
+      ChildPositions_t;
+  ChildPositions_t child_positions_;
 
   /** Associated weak pointer */
   GroupNodeWeakPtr weak_ptr_;
 
+  /** Whether identical meshes in this group are drawn with instancing */
+  bool instancing_;
+  /** Whether the instanced meshes must be recomputed at the next update
+   *  traversal */
+  bool instancing_dirty_;
+  /** Group of MeshInstancer */
+  ::osg::GroupRefPtr instancers_;
+  struct UpdateInstancing;
+
+  /** Original children replaced by merged geometries, when frozen */
+  ::osg::GroupRefPtr frozen_children_;
+  ::osg::ref_ptr< ::osg::Geode> frozen_geode_;
+
+  void init();
+
+  void clearInstancers();
+
+  /** Recompute child_positions_ */
+  void indexChildren();
+
  protected:
   /**
    \brief Default constructor
@@ -61,9 +89,24 @@ class GroupNode : public Node {
   virtual bool addChild(NodePtr_t child_ptr);
 
   /** Remove a GraphicalObject from the list
+   *  The last child takes the place of the removed one, so that the removal
+   *  takes constant time when the group is neither frozen nor instanced.
+   *  Use removeChildren to keep the order of the children.
    */
   virtual bool removeChild(NodePtr_t child_ptr);
 
+  /** Remove num children, starting from the child at position pos.
+   *  This is faster than removing them one by one.
+   *  \return false if there is no child at position pos.
+   */
+  virtual bool removeChildren(size_t pos, size_t num);
+
+  /** Remove all the occurrences of some children, in a single pass.
+   *  A frozen group merges its geometries again once for all the children.
+   *  \return false if none of them is a child of this group.
+   */
+  virtual bool removeChildren(const std::set<const Node*>& children);
+
   /** Return true if this group contains this child
    */
   virtual bool hasChild(NodePtr_t child_ptr) const;
@@ -102,6 +145,35 @@ class GroupNode : public Node {
   /** Set the color of the object */
   void setColor(const osgVector4& color);
 
+  /** Draw all the LeafNodeCollada of this group sharing the same mesh and
+   *  the same material with hardware instancing. The children of this group
+   *  stay addressable by name and can still be picked.
+   *  Adding or removing children of this group updates the instanced meshes
+   *  once, at the next update traversal.
+   *  \note Modifying the children of a subgroup is not detected. In this
+   *  case, call updateInstancing, which is also available as the
+   *  "UpdateInstancing" property (see WindowsManager::callVoidProperty).
+   */
+  void setInstancing(bool instancing);
+
+  bool getInstancing() const { return instancing_; }
+
+  /** Recompute the sets of instanced meshes */
+  void updateInstancing();
+
+  /** Replace the children of this group by merged geometries, one per
+   *  state set, in order to reduce the number of nodes to traverse and of
+   *  draw calls. The children stay addressable by name and picking resolves
+   *  the original node (see FrozenGeometry).
+   *  Children which cannot be merged, e.g. lines or text, are left as is.
+   *  \note The modifications of the frozen children, including highlighting,
+   *  are not visible until the group is unfrozen. Children added afterwards
+   *  are drawn by themselves.
+   */
+  void setFrozen(bool frozen);
+
+  bool getFrozen() const { return frozen_children_.valid(); }
+
   void traverse(NodeVisitor& visitor);
 
   virtual osg::ref_ptr<osg::Node> getOsgNode() const;
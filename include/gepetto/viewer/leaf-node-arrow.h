@@ -26,14 +26,13 @@ class LeafNodeArrow : public NodeDrawable {
   float radius_;
   /** axis components : */
   float size_;
-  ::osg::ShapeDrawableRefPtr cylinder_drawable_;
-  ::osg::ShapeDrawableRefPtr cone_drawable_;
-
-  osgVector4 color_;
+  /** Transforms of the shared unit cylinder and cone */
+  ::osg::MatrixTransformRefPtr cylinder_ptr_;
+  ::osg::MatrixTransformRefPtr cone_ptr_;
 
   void init();
 
-  void resetGeodeContent();
+  void updateShapeTransform();
 
   /* Default constructor */
   LeafNodeArrow(const std::string& name, const osgVector4& color,
@@ -76,9 +75,6 @@ class LeafNodeArrow : public NodeDrawable {
    */
   LeafNodeArrowPtr_t self(void) const;
 
-  // set color
-  void setColor(const osgVector4& color);
-  osgVector4 getColor() const { return color_; }
   /// Get the radius of the arrow.
   /// It is the cylinder radius. The cone base radius is twice larger.
   float getRadius() const;
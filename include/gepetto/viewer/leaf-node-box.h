@@ -21,8 +21,10 @@ class LeafNodeBox : public NodeDrawable {
   /** Associated weak pointer */
   LeafNodeBoxWeakPtr weak_ptr_;
 
-  /** Associated Box Shape */
-  ::osg::BoxRefPtr box_ptr_;
+  /** Half lengths of the box */
+  osgVector3 half_axis_;
+  /** Transform scaling the shared unit box */
+  ::osg::MatrixTransformRefPtr shape_transform_ptr_;
 
   void init();
 
@@ -69,7 +71,7 @@ class LeafNodeBox : public NodeDrawable {
    */
   void setHalfAxis(const osgVector3& half_axis);
 
-  osgVector3 getHalfAxis() const { return box_ptr_->getHalfLengths(); }
+  osgVector3 getHalfAxis() const { return half_axis_; }
 
   SCENE_VIEWER_ACCEPT_VISITOR;
 
@@ -22,8 +22,12 @@ class LeafNodeCapsule : public NodeDrawable {
  private:
   /** Associated weak pointer */
   LeafNodeCapsuleWeakPtr weak_ptr_;
-  /** Associated Capsule Shape */
-  ::osg::CapsuleRefPtr capsule_ptr_;
+  /** Radius and height of the capsule */
+  float radius_, height_;
+  /** Transforms of the shared unit body and caps */
+  ::osg::MatrixTransformRefPtr body_ptr_, top_ptr_, bottom_ptr_;
+
+  void updateShapeTransform();
 
   void init();
 
@@ -71,13 +75,13 @@ class LeafNodeCapsule : public NodeDrawable {
    */
   virtual void setRadius(const float& radius);
 
-  float getRadius() const { return capsule_ptr_->getRadius(); }
+  float getRadius() const { return radius_; }
 
   /** Fix the new height of the capsule
    *  \note height must be positive scalar
    */
   virtual void setHeight(const float& height);
-  float getHeight() const { return capsule_ptr_->getHeight(); }
+  float getHeight() const { return height_; }
 
   SCENE_VIEWER_ACCEPT_VISITOR;
 
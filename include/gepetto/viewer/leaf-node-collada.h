@@ -12,6 +12,8 @@
 #include <gepetto/viewer/node.h>
 #include <gepetto/viewer/properties.h>
 
+#include <osg/LOD>
+#include <osg/OcclusionQueryNode>
 #include <osgDB/ReadFile>
 
 namespace gepetto {
@@ -21,6 +23,8 @@ DEF_CLASS_SMART_PTR(LeafNodeCollada)
 /** Implementation of the Collada GraphicalObject in OSG render */
 class LeafNodeCollada : public Node {
  private:
+  friend class MeshInstancer;
+
   std::string collada_file_path_;
   std::string texture_file_path_;
 
@@ -30,6 +34,14 @@ class LeafNodeCollada : public Node {
   /** Associated Node Shape */
   ::osg::GroupRefPtr group_ptr_;
   ::osg::NodeRefPtr collada_ptr_;
+  /** Mesh shared with the nodes loading the same file. collada_ptr_ is
+   *  either this mesh or a transform applying unit_scale_ to it. */
+  ::osg::NodeRefPtr mesh_ptr_;
+  float unit_scale_;
+  /** Level of detail node, when enabled. */
+  ::osg::ref_ptr< ::osg::LOD> lod_ptr_;
+  /** Occlusion query node, when enabled. */
+  ::osg::ref_ptr< ::osg::OcclusionQueryNode> occlusion_query_ptr_;
 
   BackfaceDrawingProperty backfaceDrawing_;
 
@@ -51,6 +63,10 @@ class LeafNodeCollada : public Node {
   /** Initialize weak_ptr */
   void initWeakPtr(LeafNodeColladaWeakPtr other_weak_ptr);
 
+  /** Whether the mesh is drawn by a MeshInstancer instead of this node.
+   *  The mesh remains in the scene graph for picking. */
+  void setDrawnByInstancer(bool instanced);
+
  protected:
  public:
   /** Static method which create a new LeafNodeCollada
@@ -103,6 +119,22 @@ class LeafNodeCollada : public Node {
   /// Apply the current scale permanently to the node.
   void applyScale();
 
+  /// Enable level of detail based on the size of the mesh on screen.
+  /// Two simplified meshes are computed once and cached with the mesh. They
+  /// are also saved in the cache directory of the user, keyed by the path
+  /// and modification time of the mesh file, and read from there.
+  void setLevelOfDetail(bool enable);
+
+  bool getLevelOfDetail() const { return lod_ptr_.valid(); }
+
+  /// Enable hardware occlusion queries.
+  /// The mesh is not drawn when its bounding box is hidden by what was drawn
+  /// before. The queries cost one draw of the bounding box and only pay off
+  /// for heavy meshes.
+  void setOcclusionQuery(bool enable);
+
+  bool getOcclusionQuery() const { return occlusion_query_ptr_.valid(); }
+
   SCENE_VIEWER_ACCEPT_VISITOR;
 
   /** Remove this object from cache */
@@ -21,8 +21,12 @@ class LeafNodeCone : public NodeDrawable {
   /** Associated weak pointer */
   LeafNodeConeWeakPtr weak_ptr_;
 
-  /** Associated Cone Shape */
-  ::osg::ConeRefPtr cone_ptr_;
+  /** Radius and height of the cone */
+  float radius_, height_;
+  /** Transform scaling the shared unit cone */
+  ::osg::MatrixTransformRefPtr shape_transform_ptr_;
+
+  void updateShapeTransform();
 
   void init();
 
@@ -69,14 +73,14 @@ class LeafNodeCone : public NodeDrawable {
    */
   virtual void setRadius(const float& radius);
 
-  float getRadius() const { return cone_ptr_->getRadius(); }
+  float getRadius() const { return radius_; }
 
   /** Fix the new jeight of the cone
    * Note : radius must be positive scalar
    */
   virtual void setHeight(const float& height);
 
-  float getHeight() const { return cone_ptr_->getHeight(); }
+  float getHeight() const { return height_; }
 
   SCENE_VIEWER_ACCEPT_VISITOR;
 
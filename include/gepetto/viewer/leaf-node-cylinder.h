@@ -21,8 +21,12 @@ class LeafNodeCylinder : public NodeDrawable {
   /** Associated weak pointer */
   LeafNodeCylinderWeakPtr weak_ptr_;
 
-  /** Associated Cylinder Shape */
-  ::osg::CylinderRefPtr cylinder_ptr_;
+  /** Radius and height of the cylinder */
+  float radius_, height_;
+  /** Transform scaling the shared unit cylinder */
+  ::osg::MatrixTransformRefPtr shape_transform_ptr_;
+
+  void updateShapeTransform();
 
   void init();
 
@@ -70,14 +74,14 @@ class LeafNodeCylinder : public NodeDrawable {
    */
   void setRadius(const float& radius);
 
-  float getRadius() const { return cylinder_ptr_->getRadius(); }
+  float getRadius() const { return radius_; }
 
   /** Fix the new jeight of the cylinder
    * Note : radius must be positive scalar
    */
   void setHeight(const float& height);
 
-  float getHeight() const { return cylinder_ptr_->getHeight(); }
+  float getHeight() const { return height_; }
 
   SCENE_VIEWER_ACCEPT_VISITOR;
 
@@ -0,0 +1,143 @@
+//
+//  leaf-node-marker-array.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_LEAFNODEMARKERARRAY_HH
+#define GEPETTO_VIEWER_LEAFNODEMARKERARRAY_HH
+
+#include <gepetto/viewer/node-drawable.h>
+
+#include <osg/Image>
+#include <osg/TextureBuffer>
+#include <vector>
+
+namespace gepetto {
+namespace viewer {
+DEF_CLASS_SMART_PTR(LeafNodeMarkerArray)
+
+/** Many markers of the same shape in a single node, such as a marker array
+ *  of RViz.
+ *
+ *  Each marker has its own pose, scale and color, expressed in the frame of
+ *  the node. The markers are drawn with hardware instancing, with one draw
+ *  call per geometry of the shape. Their data is stored in a texture buffer,
+ *  which is only uploaded when it changes.
+ *
+ *  The markers are not nodes: they have no name, no property and cannot be
+ *  picked individually. The node itself is not intersected.
+ */
+class LeafNodeMarkerArray : public NodeDrawable {
+ public:
+  /** Shape of the markers, of unit size before scaling. The sphere, the box
+   *  and the cylinder are centered, the cylinder being along the Z axis. The
+   *  arrow starts at the origin and goes along the X axis. Its head has a
+   *  unit diameter and its shaft half of it.
+   */
+  enum Shape { SPHERE, BOX, CYLINDER, ARROW };
+
+ private:
+  /** Associated weak pointer */
+  LeafNodeMarkerArrayWeakPtr weak_ptr_;
+
+  Shape shape_;
+  std::size_t num_markers_;
+
+  /** Position, orientation, scale and color of each marker, as four RGBA
+   *  texels. */
+  ::osg::ref_ptr< ::osg::Image> markers_;
+  ::osg::ref_ptr< ::osg::TextureBuffer> markers_buffer_;
+  std::vector< ::osg::GeometryRefPtr> geometries_;
+  ::osg::ref_ptr< ::osg::Drawable::ComputeBoundingBoxCallback> bound_;
+
+  void init();
+  /** Add an instanced unit shape, placed in the frame of a marker. */
+  void addShape(UnitShape shape, const ::osg::Matrix& matrix);
+  /** Reallocate the data for num markers, keeping the existing ones. */
+  void allocate(std::size_t num);
+  float* marker(std::size_t i);
+  /** Notify that the data of the markers changed.
+   *  \param moved whether the poses or the scales changed. */
+  void markersChanged(bool moved);
+  void updateTransparency();
+
+ protected:
+  /* Default constructor */
+  LeafNodeMarkerArray(const std::string& name, Shape shape,
+                      const osgVector4& color);
+
+  /* Copy constructor */
+  LeafNodeMarkerArray(const LeafNodeMarkerArray& other);
+
+  /** Initialize weak_ptr */
+  void initWeakPtr(LeafNodeMarkerArrayWeakPtr other_weak_ptr);
+
+ public:
+  /** Static method which create an array without marker.
+   *  \param color color of the markers added afterwards.
+   */
+  static LeafNodeMarkerArrayPtr_t create(const std::string& name,
+                                         Shape shape,
+                                         const osgVector4& color);
+
+  /** Static method for creating a clone of array other with the copy
+   * constructor
+   */
+  static LeafNodeMarkerArrayPtr_t createCopy(LeafNodeMarkerArrayPtr_t other);
+
+  /** Proceed to a clonage of the current object defined by the copy constructor
+   */
+  LeafNodeMarkerArrayPtr_t clone(void) const;
+
+  /** Copy
+   \brief Proceed to a copy of the currend object as clone
+   */
+  LeafNodeMarkerArrayPtr_t copy() const { return clone(); }
+
+  /** Return a shared pointer of the current object
+   */
+  LeafNodeMarkerArrayPtr_t self(void) const;
+
+  Shape getShape() const { return shape_; }
+
+  /** Change the number of markers. The existing markers are kept. The new
+   *  ones are at the origin, with a unit scale and the color of the node.
+   */
+  void setNumMarkers(std::size_t num);
+  std::size_t getNumMarkers() const { return num_markers_; }
+
+  /** Set the poses of num markers, which becomes the number of markers.
+   *  \param poses num rows of (x, y, z, qx, qy, qz, qw), with a unit
+   *         quaternion.
+   */
+  void setPoses(const float* poses, std::size_t num);
+  void setPoses(const std::vector<Configuration>& poses);
+
+  /** Set the scale of the markers along their axes.
+   *  \param scales num rows of (sx, sy, sz).
+   *  \throw std::invalid_argument if num is not the number of markers.
+   */
+  void setScales(const float* scales, std::size_t num);
+  void setScales(const std::vector<osgVector3>& scales);
+
+  /** Set the colors of the markers.
+   *  \param colors num rows of (r, g, b, a).
+   *  \throw std::invalid_argument if num is not the number of markers.
+   */
+  void setColors(const float* colors, std::size_t num);
+  void setColors(const std::vector<osgVector4>& colors);
+
+  /** Set the color of the node and of all the markers. */
+  virtual void setColor(const osgVector4& color);
+
+  SCENE_VIEWER_ACCEPT_VISITOR;
+
+  /** Destructor */
+  virtual ~LeafNodeMarkerArray();
+};
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_LEAFNODEMARKERARRAY_HH */
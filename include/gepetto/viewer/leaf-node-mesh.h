@@ -29,6 +29,13 @@ class LeafNodeMesh : public Node {
 
   void init();
 
+  /** Rebuild the KD-tree used for picking, in a background thread started
+   *  at the next update traversal. */
+  void invalidateKdTree();
+
+  /** Get the material of the mesh, which holds its color */
+  osg::Material* getOrCreateMaterial();
+
   /* Default constructor */
   LeafNodeMesh(const std::string& name);
   /* Copy constructor */
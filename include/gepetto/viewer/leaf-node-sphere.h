@@ -21,8 +21,10 @@ class LeafNodeSphere : public NodeDrawable {
   /** Associated weak pointer */
   LeafNodeSphereWeakPtr weak_ptr_;
 
-  /** Associated Sphere Shape */
-  ::osg::SphereRefPtr sphere_ptr_;
+  /** Radius of the sphere */
+  float radius_;
+  /** Transform scaling the shared unit sphere */
+  ::osg::MatrixTransformRefPtr shape_transform_ptr_;
 
   void init();
 
@@ -69,7 +71,7 @@ class LeafNodeSphere : public NodeDrawable {
    * Note : radius must be positive vector
    */
   void setRadius(const float& radius);
-  float getRadius() const { return sphere_ptr_->getRadius(); }
+  float getRadius() const { return radius_; }
 
   SCENE_VIEWER_ACCEPT_VISITOR;
 
@@ -0,0 +1,113 @@
+//
+//  leaf-node-tube.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_LEAFNODETUBE_HH
+#define GEPETTO_VIEWER_LEAFNODETUBE_HH
+
+#include <gepetto/viewer/node-drawable.h>
+
+#include <vector>
+
+namespace gepetto {
+namespace viewer {
+DEF_CLASS_SMART_PTR(LeafNodeTube)
+
+/** Smooth tube around a polyline, such as a cable or a deformable rod.
+ *
+ *  The tube mesh is generated on the CPU directly in the vertex buffers, with
+ *  frames transported along the polyline so that the tube does not twist.
+ *  Updating the centerline with the same number of points only rewrites the
+ *  vertex and normal buffers; the triangles are built once.
+ */
+class LeafNodeTube : public NodeDrawable {
+ private:
+  /** Associated weak pointer */
+  LeafNodeTubeWeakPtr weak_ptr_;
+
+  std::vector<osgVector3> points_;
+  /** Radius at each point. When empty, radius_ is used everywhere. */
+  std::vector<float> radii_;
+  float radius_;
+
+  ::osg::GeometryRefPtr tube_ptr_;
+  ::osg::Vec3ArrayRefPtr vertices_, normals_;
+  ::osg::ref_ptr< ::osg::DrawElementsUInt> triangles_;
+
+  void init();
+  /** Build the triangles for the current number of points. */
+  void buildTriangles();
+  /** Compute the vertices and normals from the points and radii. */
+  void updateVertices();
+
+ protected:
+  /* Default constructor */
+  LeafNodeTube(const std::string& name, const std::vector<osgVector3>& points,
+               const float& radius, const osgVector4& color);
+
+  /* Copy constructor */
+  LeafNodeTube(const LeafNodeTube& other);
+
+  /** Initialize weak_ptr */
+  void initWeakPtr(LeafNodeTubeWeakPtr other_weak_ptr);
+
+ public:
+  /** Static method which create a new tube around a polyline.
+   *  \throw std::invalid_argument if there are less than two points.
+   */
+  static LeafNodeTubePtr_t create(const std::string& name,
+                                  const std::vector<osgVector3>& points,
+                                  const float& radius,
+                                  const osgVector4& color);
+
+  /** Static method for creating a clone of tube other with the copy
+   * constructor
+   */
+  static LeafNodeTubePtr_t createCopy(LeafNodeTubePtr_t other);
+
+  /** Proceed to a clonage of the current object defined by the copy constructor
+   */
+  LeafNodeTubePtr_t clone(void) const;
+
+  /** Copy
+   \brief Proceed to a copy of the currend object as clone
+   */
+  LeafNodeTubePtr_t copy() const { return clone(); }
+
+  /** Return a shared pointer of the current object
+   */
+  LeafNodeTubePtr_t self(void) const;
+
+  /** Set the centerline of the tube.
+   *  \throw std::invalid_argument if there are less than two points.
+   *  \note When the number of points changes, the radii set with setRadii
+   *        are discarded.
+   */
+  void setPoints(const std::vector<osgVector3>& points);
+  const std::vector<osgVector3>& getPoints() const { return points_; }
+
+  /** Set a radius per point.
+   *  \param radii either empty, to use the uniform radius, or one radius
+   *         per point.
+   *  \throw std::invalid_argument if the size does not match.
+   */
+  void setRadii(const std::vector<float>& radii);
+  const std::vector<float>& getRadii() const { return radii_; }
+
+  /** Set a uniform radius and discard the radii set with setRadii.
+   */
+  void setRadius(const float& radius);
+  float getRadius() const { return radius_; }
+
+  SCENE_VIEWER_ACCEPT_VISITOR;
+
+  /** Destructor */
+  virtual ~LeafNodeTube();
+};
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_LEAFNODETUBE_HH */
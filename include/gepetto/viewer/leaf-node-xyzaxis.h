@@ -26,7 +26,7 @@ class LeafNodeXYZAxis : public NodeDrawable {
 
   /** Sphere component */
   float radius_;
-  ::osg::SphereRefPtr sphere_ptr_;
+  ::osg::MatrixTransformRefPtr sphere_ptr_;
 
   /** axis components : */
   float sizeAxis_;
@@ -0,0 +1,64 @@
+//
+//  memory-usage-visitor.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_MEMORY_USAGE_VISITOR_HH
+#define GEPETTO_VIEWER_MEMORY_USAGE_VISITOR_HH
+
+#include <gepetto/viewer/config-osg.h>
+#include <gepetto/viewer/node-visitor.h>
+
+#include <map>
+#include <set>
+
+namespace gepetto {
+namespace viewer {
+
+/// Memory used by a node and by the subtree it is the root of.
+struct MemoryUsage {
+  /// Bytes used by the node alone, excluding its children.
+  std::size_t cpuBytes, gpuBytes;
+  /// Bytes used by the node and all its descendants.
+  std::size_t subtreeCpuBytes, subtreeGpuBytes;
+
+  MemoryUsage()
+      : cpuBytes(0), gpuBytes(0), subtreeCpuBytes(0), subtreeGpuBytes(0) {}
+};
+
+DEF_CLASS_SMART_PTR(MemoryUsageVisitor)
+
+/// Compute the memory used by nodes.
+///
+/// The CPU bytes account for the vertex arrays, primitive sets, images and
+/// OSG drawables of a node, and for its overhead (see
+/// Node::getOverheadBytes). The GPU bytes are an estimate of the buffer
+/// objects, display lists and textures created from this data.
+///
+/// Data shared between several nodes, such as cached meshes or textures, is
+/// counted once, in the first visited node using it.
+class MemoryUsageVisitor : public NodeVisitor {
+ public:
+  MemoryUsageVisitor() : NodeVisitor(true) {}
+
+  virtual void apply(Node& node);
+
+  /// Memory used by a visited node.
+  /// \throw std::invalid_argument if the node was not visited.
+  const MemoryUsage& usage(const Node& node) const;
+
+  /// Memory used by all the visited nodes.
+  const MemoryUsage& total() const { return total_; }
+
+ private:
+  typedef std::map<const Node*, MemoryUsage> Usages_t;
+  Usages_t usages_;
+  MemoryUsage total_;
+  std::set<const osg::Referenced*> counted_;
+}; /* class MemoryUsageVisitor */
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_MEMORY_USAGE_VISITOR_HH */
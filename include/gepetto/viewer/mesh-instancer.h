@@ -0,0 +1,95 @@
+//
+//  mesh-instancer.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_MESH_INSTANCER_HH
+#define GEPETTO_VIEWER_MESH_INSTANCER_HH
+
+#include <gepetto/viewer/leaf-node-collada.h>
+
+#include <osg/Group>
+#include <osg/TextureBuffer>
+
+namespace gepetto {
+namespace viewer {
+
+/// Draw several LeafNodeCollada sharing the same mesh with hardware
+/// instancing.
+///
+/// The instancer holds a copy of the primitive sets of the shared mesh (the
+/// vertex arrays are shared) and draws it once per instance with a single
+/// draw call per geometry. The transform of each instance is read, at every
+/// update traversal, from the scene graph path of the corresponding
+/// LeafNodeCollada and sent to the GPU through a texture buffer.
+///
+/// The instanced LeafNodeCollada are not drawn by themselves anymore but they
+/// stay in the scene graph: they keep their name and can still be picked,
+/// hidden or moved. Highlighted instances are drawn by their own node so that
+/// the selection feedback stays visible, as well as the instances which are
+/// not influenced by light.
+///
+/// The instances are lit by the first light source in the vertex shader.
+/// Only the texture unit 0 is supported. Meshes with vertex colors or other
+/// texture units are not instanced (see canInstance).
+///
+/// In the id buffer of a window, the instances are drawn with the id
+/// reserved to instanced meshes, for which WindowManager::getNodeAt falls
+/// back to ray picking.
+class MeshInstancer : public ::osg::Group {
+ public:
+  /// Unit used to bind the texture buffer of instance transforms.
+  static const unsigned int TextureUnit;
+
+  /// \param leaf first instance, which defines the mesh and its material.
+  MeshInstancer(const LeafNodeColladaPtr_t& leaf);
+
+  /// Whether the mesh of \c leaf can be drawn with the shader of the
+  /// instancers.
+  static bool canInstance(const LeafNodeColladaPtr_t& leaf);
+
+  /// Whether \c leaf can be drawn by this instancer, i.e. if it shares the
+  /// same cached mesh and the same material. The unit scale of a DAE file is
+  /// part of the instance transform.
+  bool accepts(const LeafNodeColladaPtr_t& leaf) const;
+
+  /// Add an instance. It must be accepted by this instancer.
+  void addInstance(const LeafNodeColladaPtr_t& leaf);
+
+  /// Give back the drawing of each instance to its own node.
+  void clear();
+
+  std::size_t getNumInstances() const { return instances_.size(); }
+
+  /// Update the transforms of the instances. This is called during the
+  /// update traversal.
+  void updateInstances();
+
+ protected:
+  virtual ~MeshInstancer();
+
+ private:
+  typedef std::vector<LeafNodeColladaWeakPtr> Instances_t;
+  Instances_t instances_;
+
+  osg::ref_ptr<osg::Node> mesh_;
+  osg::ref_ptr<osg::StateSet> material_;
+  /// State of the node applying the unit scale of the mesh, if any.
+  osg::ref_ptr<osg::StateSet> mesh_state_;
+
+  osg::ref_ptr<osg::Node> instanced_mesh_;
+  osg::ref_ptr<osg::Image> matrices_;
+  osg::ref_ptr<osg::TextureBuffer> matrices_buffer_;
+  std::vector<osg::PrimitiveSet*> primitives_;
+  unsigned int numDrawn_;
+
+  void setNumDrawn(unsigned int n);
+}; /* class MeshInstancer */
+
+DEF_OSG_CLASS_REF_PTR(MeshInstancer)
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_MESH_INSTANCER_HH */
@@ -20,10 +20,34 @@ class NodeDrawable : public Node {
  private:
   void init();
 
+  /// Root of the unit shapes of this node.
+  ::osg::GroupRefPtr unit_shapes_ptr_;
+
  protected:
-  ::osg::ShapeDrawableRefPtr shape_drawable_ptr_;
+  /// Get the geometry of a unit shape, shared by all the nodes.
+  static ::osg::Geometry* unitShape(int shape);
+
+  /// Shapes of unit size whose vertex data is shared by all the nodes.
+  /// The box has unit half lengths. The others have unit radius and height,
+  /// along the Z axis. The capsule is made of a body and of two caps of zero
+  /// height.
+  enum UnitShape {
+    UNIT_BOX,
+    UNIT_SPHERE,
+    UNIT_CYLINDER,
+    UNIT_CONE,
+    UNIT_CAPSULE_BODY,
+    UNIT_CAPSULE_TOP,
+    UNIT_CAPSULE_BOTTOM,
+    NB_UNIT_SHAPES
+  };
+
+  /// Color of the node, bound overall to the geometries of the unit shapes.
+  ::osg::Vec4ArrayRefPtr colors_;
 
-  void redrawShape();
+  /// Add an instance of a unit shape to this node.
+  /// \return the transform which sets the size of the instance.
+  ::osg::MatrixTransform* addUnitShape(UnitShape shape);
 
   /** Constructor */
   NodeDrawable(const std::string& name) : Node(name) { init(); }
@@ -47,7 +71,7 @@ class NodeDrawable : public Node {
   virtual void setTexture(const std::string& image_path);
 
   /** Destructor */
-  virtual ~NodeDrawable() {}
+  virtual ~NodeDrawable();
 };
 } /* namespace viewer */
 } /* namespace gepetto */
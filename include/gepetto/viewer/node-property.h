@@ -110,10 +110,18 @@ QWidget* buildEditor<Configuration>(Property* property);
 }  // namespace details
 /// \endcond
 
-/// Abstract base class for runtime properties of Node.
-class Property : public QObject {
+/// QObject relaying the changes of a Property to its editors.
+///
+/// It is created by Property::notifier, when an editor needs it. Properties
+/// without editors are thus set and read through plain function calls.
+class PropertyNotifier : public QObject {
   Q_OBJECT
 
+ public:
+  PropertyNotifier(Property* property);
+
+  Property* property() const { return property_; }
+
  public slots:
   bool set(void);
   bool set(const bool& v);
@@ -134,24 +142,6 @@ class Property : public QObject {
   // Provide slots to convert from QColor to osgVector4.
   bool set(const QColor& v);
 
- public:
-  bool get(void);
-  bool get(bool& v);
-  bool get(int& v);
-  bool get(float& v);
-  bool get(std::string& v);
-  bool get(osgVector2& v);
-  bool get(osgVector3& v);
-  bool get(osgVector4& v);
-  bool get(Configuration& v);
-
-  // Provide slots to convert from double to float.
-  bool get(double& v);
-  // Provide slots to convert from QString to std::string.
-  bool get(QString& v);
-  // Provide slots to convert from QColor to osgVector4.
-  bool get(QColor& v);
-
  signals:
   void valueChanged(void);
   void valueChanged(const bool& v);
@@ -170,7 +160,57 @@ class Property : public QObject {
   // Provide slots to convert from QColor to osgVector4
   void valueChanged(const QColor& v);
 
+ private:
+  Property* property_;
+
+  friend class Property;
+};
+
+/// Abstract base class for runtime properties of Node.
+class Property {
  public:
+  bool set(void);
+  bool set(const bool& v);
+  bool set(const int& v);
+  bool set(const float& v);
+  bool set(const std::string& v);
+  bool set(const osgVector2& v);
+  bool set(const osgVector3& v);
+  bool set(const osgVector4& v);
+  bool set(const Configuration& v);
+
+  // Convert from double to float.
+  bool set(const double& v);
+
+  // Convert from QString to std::string.
+  bool set(const QString& v);
+
+  // Convert from QColor to osgVector4.
+  bool set(const QColor& v);
+
+  bool get(void);
+  bool get(bool& v);
+  bool get(int& v);
+  bool get(float& v);
+  bool get(std::string& v);
+  bool get(osgVector2& v);
+  bool get(osgVector3& v);
+  bool get(osgVector4& v);
+  bool get(Configuration& v);
+
+  // Convert from double to float.
+  bool get(double& v);
+  // Convert from QString to std::string.
+  bool get(QString& v);
+  // Convert from QColor to osgVector4.
+  bool get(QColor& v);
+
+  /// Get the QObject emitting the valueChanged signals and providing the
+  /// set slots. It is created on the first call.
+  PropertyNotifier* notifier();
+
+  bool hasNotifier() const { return notifier_ != NULL; }
+
   virtual bool hasReadAccess() const = 0;
   virtual bool hasWriteAccess() const = 0;
 
@@ -182,6 +222,20 @@ class Property : public QObject {
   ///         a valid new QWidget.
   virtual QWidget* guiEditor() { return NULL; }
 
+  /// Set the value without emitting valueChanged.
+  /// Call notifyValueChanged afterwards to update the editors.
+  template <typename T>
+  bool setWithoutNotification(const T& v) {
+    if (notifier_ == NULL) return set(v);
+    const bool wasBlocked = notifier_->blockSignals(true);
+    bool res = set(v);
+    notifier_->blockSignals(wasBlocked);
+    return res;
+  }
+
+  /// Emit valueChanged with the current value.
+  virtual void notifyValueChanged() {}
+
  protected:
   virtual bool impl_set(void);
   virtual bool impl_set(const bool& v);
@@ -203,10 +257,19 @@ class Property : public QObject {
   virtual bool impl_get(osgVector4& v);
   virtual bool impl_get(Configuration& v);
 
+  void emitValueChanged(const bool& v);
+  void emitValueChanged(const int& v);
+  void emitValueChanged(const float& v);
+  void emitValueChanged(const std::string& v);
+  void emitValueChanged(const osgVector2& v);
+  void emitValueChanged(const osgVector3& v);
+  void emitValueChanged(const osgVector4& v);
+  void emitValueChanged(const Configuration& v);
+
  protected:
   Property(const std::string& name);
 
-  virtual ~Property() {}
+  virtual ~Property();
 
   const std::string name_;
 
@@ -216,6 +279,13 @@ class Property : public QObject {
   inline void invalidSet() const {
     throw std::logic_error("Cannot write property " + name_ + ".");
   }
+
+ private:
+  PropertyNotifier* notifier_;
+
+  // Properties are not copyable, as they used to be QObject.
+  Property(const Property&);
+  Property& operator=(const Property&);
 };
 
 class VoidProperty : public Property {
@@ -357,6 +427,11 @@ class PropertyTpl : public Property {
 
   virtual QWidget* guiEditor() { return details::buildEditor<T>(this); }
 
+  virtual void notifyValueChanged() {
+    T value;
+    if (hasReadAccess() && impl_get(value)) emitValueChanged(value);
+  }
+
  protected:
   virtual bool impl_set(const T& value) {
     if (!hasWriteAccess()) {
@@ -500,6 +575,8 @@ class StoredPropertyTpl : public Property {
   const Callback_t& callback() const { return callback_; }
   void callback(const Callback_t& s) { callback_ = s; }
 
+  virtual void notifyValueChanged() { emitValueChanged(value); }
+
   T value;
 
  protected:
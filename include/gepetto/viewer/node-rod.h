@@ -29,6 +29,23 @@ class NodeRod : public Node {
   float radius_;
   float totalLength_;
   size_t maxCapsule_;  // max number of capsule for this rod
+
+  /** Length and pose of each capsule */
+  std::vector<float> lengths_;
+  std::vector<Configuration> poses_;
+
+  /** Tube swept along the capsules, when enabled */
+  ::osg::GeodeRefPtr tube_ptr_;
+  ::osg::Vec3ArrayRefPtr tube_vertices_, tube_normals_;
+  ::osg::Vec4ArrayRefPtr tube_colors_;
+
+  void createTube();
+  void updateTube();
+  void setTubeRing(unsigned int ring, const osgVector3& base,
+                   const osgQuat& quat, const osgVector3& axis, float phi);
+  /** Apply lengths_ and poses_ to the capsules or to the tube. */
+  void updateCapsules();
+
  protected:
   /** Default constructor */
   NodeRod(const std::string& name, osgVector4 color, float radius,
@@ -59,13 +76,28 @@ class NodeRod : public Node {
 
   virtual float totalLength() const { return totalLength_; }
 
-  void setColor(const osgVector4& color) { color_ = color; }
+  void setColor(const osgVector4& color);
 
   virtual osgVector4 color() const { return color_; }
 
   virtual size_t maxCapsule() const { return maxCapsule_; }
 
   virtual void applyConfiguration(std::vector<std::vector<value_type> > params);
+
+  /// Set the length and pose of all the capsules at once.
+  /// \param params maxCapsule() consecutive blocks of either 8 values
+  ///        (length, position, quaternion) or 7 values (position,
+  ///        quaternion). Quaternions are (w, x, y, z).
+  /// \param size number of values, either 8 * maxCapsule() or
+  ///        7 * maxCapsule().
+  void applyConfiguration(const value_type* params, std::size_t size);
+
+  /// Draw the rod as a single tube swept along the capsules, instead of one
+  /// node per capsule. An update then rewrites one vertex buffer.
+  /// \note In this mode, the capsule nodes are not updated.
+  void setTube(bool tube);
+
+  bool getTube() const { return tube_ptr_.valid(); }
 };
 } /* namespace viewer */
 } /* namespace gepetto */
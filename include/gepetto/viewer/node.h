@@ -39,11 +39,15 @@ class Node : public Properties {
   /** TODO: The use of multiswitch may be better */
   osg::GroupRefPtr switch_node_ptr_;
   WireFrameMode selected_wireframe_;
-  std::vector< ::osg::GroupRefPtr> wireframe_modes_;
+  /** Parent of hl_switch_node_ptr_ in WIREFRAME mode. Created on first use.
+   *  In FILL mode, hl_switch_node_ptr_ is a child of switch_node_ptr_. */
+  osg::GroupRefPtr wireframe_node_ptr_;
 
   osg::GroupRefPtr hl_switch_node_ptr_;
   std::size_t selected_highlight_;
   bool highlight_enabled_;
+  /** Parent of transform_ptr_ for each highlight state. Created on first
+   *  use, the first element being transform_ptr_ itself. */
   std::vector< ::osg::GroupRefPtr> highlight_nodes_;
 
   VisibilityMode visibilityMode_;
@@ -56,6 +60,10 @@ class Node : public Properties {
 
   ::osg::Group* setupHighlightState(unsigned int state);
 
+  const ::osg::GroupRefPtr& getOrCreateHighlightNode(unsigned int state);
+
+  const ::osg::GroupRefPtr& getOrCreateWireframeNode();
+
  protected:
   /** protected because it's used in LeafNodeCapsule */
   ::osg::GeodeRefPtr landmark_geode_ptr_;
@@ -219,6 +227,11 @@ class Node : public Properties {
   void setTransparency(const float& transparency);
   float getTransparency() const;
 
+  /// Estimate of the memory used by this node for its own structure, i.e.
+  /// the scene graph nodes implementing highlight, wireframe and landmark,
+  /// and the properties. The displayed geometry is not counted.
+  std::size_t getOverheadBytes() const;
+
   SCENE_VIEWER_ACCEPT_VISITOR;
   virtual void traverse(NodeVisitor& visitor);
 
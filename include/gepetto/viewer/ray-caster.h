@@ -0,0 +1,66 @@
+//
+//  ray-caster.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_RAY_CASTER_HH
+#define GEPETTO_VIEWER_RAY_CASTER_HH
+
+#include <gepetto/viewer/config-osg.h>
+
+#include <string>
+#include <vector>
+
+namespace gepetto {
+namespace viewer {
+
+/// Nearest intersection of a ray with a scene.
+struct RayHit {
+  /// Distance from the origin of the ray, negative when nothing was hit.
+  float distance;
+  osgVector3 point, normal;
+  /// Name of the node which was hit, empty when nothing was hit.
+  std::string node;
+
+  RayHit() : distance(-1.f), point(0, 0, 0), normal(0, 0, 0) {}
+
+  bool hit() const { return distance >= 0; }
+};
+
+/// Cast many rays against a scene in parallel threads.
+///
+/// The rays are intersected with the bounding volume hierarchy of the scene
+/// graph, and with the KD-trees of the meshes when they have one (see
+/// LeafNodeMesh and LeafNodeCollada). No window nor graphics context is
+/// needed.
+class RayCaster {
+ public:
+  /// \param numThreads number of threads, 0 for one per processor.
+  RayCaster(unsigned int numThreads = 0);
+
+  /// Rays longer than this distance hit nothing.
+  void setMaxDistance(const float& distance) { maxDistance_ = distance; }
+  float getMaxDistance() const { return maxDistance_; }
+
+  /// Cast rays against the selectable nodes below a node.
+  ///
+  /// The rays and the hits are expressed in the frame the node is placed in,
+  /// that is the world frame for a window or a scene.
+  /// \param directions need not be normalized.
+  /// \throw std::invalid_argument if there are not as many directions as
+  ///        origins.
+  /// \warning The scene must not be modified during the call.
+  std::vector<RayHit> cast(const NodePtr_t& node,
+                           const std::vector<osgVector3>& origins,
+                           const std::vector<osgVector3>& directions) const;
+
+ private:
+  unsigned int numThreads_;
+  float maxDistance_;
+}; /* class RayCaster */
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_RAY_CASTER_HH */
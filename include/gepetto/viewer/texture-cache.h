@@ -0,0 +1,65 @@
+//
+//  texture-cache.h
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_TEXTURE_CACHE_HH
+#define GEPETTO_VIEWER_TEXTURE_CACHE_HH
+
+#include <gepetto/viewer/config-osg.h>
+
+#include <osg/Texture2D>
+
+namespace gepetto {
+namespace viewer {
+
+/// Cache of the textures loaded from image files.
+///
+/// Nodes using the same image file share the same osg::Texture2D, as long as
+/// one of them uses it.
+/// Textures are mipmapped. When a file named after the image with extension
+/// \c .dds or \c .ktx exists (e.g. \c wood.png.dds) and is up to date, it
+/// is loaded instead. Such a file may contain compressed data and
+/// pre-computed mipmaps. Otherwise, if an image processor plugin such as
+/// nvtt is available, the mipmaps are computed, the image is compressed in
+/// DXT if requested, and the result is saved in a \c .dds file in the cache
+/// directory of the user, keyed by the path and modification time of the
+/// image.
+class TextureCache {
+ public:
+  /// Compression used by the driver for textures which are not compressed
+  /// on disk.
+  enum Compression { NO_COMPRESSION, DXT_COMPRESSION, ETC_COMPRESSION };
+
+  enum Filtering {
+    /// Linear interpolation between pixels and mipmaps.
+    MIPMAP_FILTERING,
+    /// No interpolation between pixels and no resizing to power of two.
+    NEAREST_FILTERING
+  };
+
+  /// Get the texture of an image file, loading it if needed.
+  /// \return NULL if the file cannot be read.
+  static osg::ref_ptr<osg::Texture2D> get(
+      const std::string& imagePath, Filtering filtering = MIPMAP_FILTERING);
+
+  /// Set the compression of the textures loaded afterwards.
+  static void setCompression(Compression compression);
+
+  static Compression getCompression();
+
+  /// Set the compression from a string: "none", "dxt" or "etc".
+  /// \return false if the string is not recognized.
+  static bool setCompression(const std::string& compression);
+
+  /// Forget the textures which are not used anymore. Textures are released
+  /// with the last node using them, this only cleans the cache. Nothing is
+  /// done when no texture was released since the last call.
+  static void prune();
+};
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_TEXTURE_CACHE_HH */
@@ -9,6 +9,7 @@
 #ifndef GEPETTO_VIEWER_WINDOWMANAGER_HH
 #define GEPETTO_VIEWER_WINDOWMANAGER_HH
 
+#include <gepetto/viewer/camera-sensor.h>
 #include <gepetto/viewer/group-node.h>
 
 #include <osgGA/KeySwitchMatrixManipulator>
@@ -20,6 +21,16 @@ namespace viewer {
 
 DEF_CLASS_SMART_PTR(WindowManager)
 
+/// Number of drawables of the scene of a window during the last frame.
+struct CullingStatistics {
+  /// Drawables sent to the graphics card, counting each rendering pass.
+  std::size_t drawn;
+  /// Drawables of visible nodes which were not sent to the graphics card.
+  std::size_t culled;
+
+  CullingStatistics() : drawn(0), culled(0) {}
+};
+
 /// Manage a window that renders a scene.
 /// The root of the rendered scene is a \ref GroupNode.
 class WindowManager : public GroupNode {
@@ -52,6 +63,18 @@ class WindowManager : public GroupNode {
   bool textActive_[3][3];
 
   bool lastSceneWasDisrty_;
+  bool occlusionQueries_;
+
+  /** Camera rendering the ids of the nodes, for picking. NULL when disabled.
+   */
+  ::osg::CameraRefPtr id_camera_;
+  osg::ref_ptr< ::osg::Image> id_image_;
+  /** Node of each id, the id i being at index i - 1. */
+  std::vector<NodeWeakPtr> id_nodes_;
+  /** Main camera matrices when the id buffer was last updated. */
+  ::osg::Matrix id_view_, id_projection_;
+
+  std::map<std::string, CameraSensorPtr_t> sensors_;
 
   osg::ref_ptr<osgGA::KeySwitchMatrixManipulator> manipulator_ptr;
   /** Associated weak pointer */
@@ -64,6 +87,16 @@ class WindowManager : public GroupNode {
 
   void createHUDcamera();
 
+  void createCullingProperties();
+
+  void createIdCamera();
+  /** Resize the id buffer and number the nodes again if needed. */
+  void updateIdBuffer(bool sceneChanged);
+  /** Remove the ids given to the nodes by numbering them. */
+  void removeIdCullCallbacks();
+  /** Node found by ray picking, among the numbered nodes. */
+  NodePtr_t getNodeIntersectedAt(const float& x, const float& y) const;
+
   void init(osg::GraphicsContext* gc);
 
   void init(osgViewer::Viewer* v, osg::GraphicsContext* gc);
@@ -190,6 +223,50 @@ class WindowManager : public GroupNode {
 
   void attachCameraToNode(NodePtr_t node);
   void detachCamera();
+
+  /// Set the screen size, in pixels, under which objects are not drawn.
+  /// \param pixels 0 disables small feature culling.
+  void setSmallFeatureCullingPixelSize(const float& pixels);
+  float getSmallFeatureCullingPixelSize() const;
+
+  /// Enable hardware occlusion queries for the meshes of the scene having
+  /// many vertices.
+  /// Meshes added afterwards are not affected until the queries are enabled
+  /// again. Each mesh can also be configured with its \c OcclusionQuery
+  /// property.
+  /// \sa LeafNodeCollada::setOcclusionQuery
+  void setOcclusionQueries(const bool& enable);
+  bool getOcclusionQueries() const { return occlusionQueries_; }
+
+  /// Number of drawn and culled drawables during the last frame.
+  /// The statistics are collected from the first call on. Zeros are returned
+  /// until a frame has been rendered.
+  CullingStatistics getCullingStatistics();
+
+  /// Render the ids of the nodes into an offscreen buffer, at a reduced
+  /// resolution, for picking with getNodeAt.
+  /// The buffer is rendered again only when the camera or the scene changes.
+  void setIdPicking(const bool& enable);
+  bool getIdPicking() const { return id_camera_.valid(); }
+
+  /// Node drawn at a pixel of the window, read from the id buffer.
+  /// \param x, y window coordinates, from the bottom left corner.
+  /// \return NULL if id picking is disabled or no node is drawn there.
+  /// \note A node which is not the child of a GroupNode, such as a capsule
+  ///       of a NodeRod, is reported as its closest ancestor which is.
+  /// \note The meshes drawn by a MeshInstancer are found by ray picking
+  ///       through the numbered nodes, where the id buffer shows one.
+  NodePtr_t getNodeAt(const float& x, const float& y) const;
+
+  /// Render the scene of the window from a sensor, at each frame of the
+  /// window in which the sensor is due.
+  /// \throw std::invalid_argument if the window has a sensor with the same
+  ///        name.
+  void addCameraSensor(const CameraSensorPtr_t& sensor);
+  /// \throw std::invalid_argument if the window has no such sensor.
+  void removeCameraSensor(const std::string& name);
+  /// \return NULL if the window has no such sensor.
+  CameraSensorPtr_t getCameraSensor(const std::string& name) const;
 };
 } /* namespace viewer */
 } /* namespace gepetto */
@@ -19,10 +19,14 @@
 
 #include <gepetto/viewer/config-osg.h>
 #include <gepetto/viewer/fwd.h>
+#include <gepetto/viewer/memory-usage-visitor.h>
+#include <gepetto/viewer/ray-caster.h>
 #include <gepetto/viewer/transform-writer.h>
 
 #include <OpenThreads/Mutex>
 #include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <set>
 
 namespace gepetto {
 namespace viewer {
@@ -59,9 +63,17 @@ class WindowsManager {
   WindowManagerMap_t windowManagers_;
   std::map<std::string, NodePtr_t> nodes_;
   std::map<std::string, GroupNodePtr_t> groupNodes_;
+  /// Names of the groups containing each node, so that a node is removed
+  /// from its parents without scanning all the groups. The windows and the
+  /// children added with GroupNode::addChild are not recorded: deleteNodes
+  /// scans the groups for the nodes having more parents than recorded.
+  std::map<std::string, std::set<std::string> > parents_;
   std::map<std::string, RoadmapViewerPtr_t> roadmapNodes_;
   Mutex osgFrameMtx_;
   BlenderFrameCapture blenderCapture_;
+  /// Thread destroying the last nodes deleted by deleteNodes.
+  OpenThreads::Thread* releaseThread_;
+  Mutex releaseMtx_;
 
   static osgVector4 getColor(const std::string& colorName);
   static std::string parentName(const std::string& name);
@@ -71,8 +83,11 @@ class WindowsManager {
   NodePtr_t find(const std::string name,
                  GroupNodePtr_t group = GroupNodePtr_t());
   void initParent(NodePtr_t node, GroupNodePtr_t parent);
+  void removeParent(const std::string& nodeName, const std::string& groupName);
   bool loadUDRF(const std::string& urdfName, const std::string& urdfPath,
                 bool visual, bool linkFrame);
+  /// Destroy nodes in a background thread, after the previous ones.
+  void releaseNodes(std::vector<NodePtr_t>& nodes);
 
  protected:
   /**
@@ -101,14 +116,25 @@ class WindowsManager {
                 bool guessParent = false);
   virtual void addGroup(const std::string& groupName, GroupNodePtr_t group,
                         GroupNodePtr_t parent);
+  /// Called by deleteNodes with the names of the deleted nodes, after they
+  /// were removed from the scene and before they are released.
+  virtual void nodesDeleted(const std::vector<std::string>& nodeNames) {
+    (void)nodeNames;
+  }
 
  public:
   static WindowsManagerPtr_t create();
 
-  virtual ~WindowsManager() {};
+  virtual ~WindowsManager();
 
   virtual std::vector<std::string> getNodeList();
+  /// Names of the nodes starting with a prefix, such as "robot/".
+  virtual std::vector<std::string> getNodeList(const std::string& prefix);
   virtual std::vector<std::string> getGroupNodeList(const std::string& group);
+  /// Names of the children of a group.
+  /// \param recursive whether to also list the descendants of the children.
+  virtual std::vector<std::string> getGroupNodeList(const std::string& group,
+                                                    bool recursive);
   virtual std::vector<std::string> getSceneList();
   virtual std::vector<std::string> getWindowList();
 
@@ -126,6 +152,25 @@ class WindowsManager {
                                   const WindowID windowId);
   virtual bool detachCamera(const WindowID windowId);
 
+  /// Add an RGB-D camera attached to a node, rendering the scene of a window.
+  /// \param fovy vertical field of view, in radians.
+  /// \param zNear, zFar range of the sensor.
+  /// \sa CameraSensor
+  virtual bool addCameraSensor(const std::string& sensorName,
+                               const WindowID windowId,
+                               const std::string& nodeName, const int width,
+                               const int height, const float fovy,
+                               const float zNear, const float zFar);
+  virtual bool removeCameraSensor(const std::string& sensorName,
+                                  const WindowID windowId);
+  /// Set the number of renderings of a sensor per second, 0 to render it at
+  /// each frame of the window.
+  virtual bool setCameraSensorRate(const std::string& sensorName,
+                                   const WindowID windowId, const float rate);
+  /// \throw std::invalid_argument if the sensor does not exist.
+  CameraSensorPtr_t getCameraSensor(const std::string& sensorName,
+                                    const WindowID windowId) const;
+
   virtual bool nodeExists(const std::string& name);
 
   virtual bool addFloor(const std::string& floorName);
@@ -147,6 +192,10 @@ class WindowsManager {
 
   virtual bool addRod(const std::string& rodName, const Color_t& color,
                       const float radius, const float length, short maxCapsule);
+  /// Set the length and pose of all the capsules of a rod at once.
+  /// \sa NodeRod::applyConfiguration(const value_type*, std::size_t)
+  virtual bool applyRodConfiguration(const std::string& rodName,
+                                     const std::vector<float>& params);
 
   virtual bool resizeCapsule(const std::string& capsuleName, float newHeight);
   virtual bool resizeArrow(const std::string& arrowName, float newRadius,
@@ -154,6 +203,9 @@ class WindowsManager {
 
   virtual bool addMesh(const std::string& meshName,
                        const std::string& meshPath);
+  /// \param levelOfDetail see LeafNodeCollada::setLevelOfDetail
+  virtual bool addMesh(const std::string& meshName, const std::string& meshPath,
+                       bool levelOfDetail);
   /// See LeafNodeCollada::removeLightSources()
   virtual void removeLightSources(const std::string& meshName);
 
@@ -194,6 +246,35 @@ class WindowsManager {
   virtual bool setCurveLineWidth(const std::string& curveName,
                                  const float& width);
 
+  /// Add a smooth tube around a polyline, such as a cable.
+  /// \sa LeafNodeTube
+  virtual bool addTube(const std::string& tubeName,
+                       const std::vector<osgVector3>& points,
+                       const float radius, const Color_t& color);
+  /// Move the centerline of a tube. Keeping the same number of points only
+  /// updates the vertex buffers.
+  virtual bool setTubePoints(const std::string& tubeName,
+                             const std::vector<osgVector3>& points);
+  /// \param radii one radius per point, or empty for a uniform radius.
+  virtual bool setTubeRadii(const std::string& tubeName,
+                            const std::vector<float>& radii);
+
+  /// Add many markers of the same shape, drawn with a single node.
+  /// \param shape "SPHERE", "BOX", "CYLINDER" or "ARROW".
+  /// \param color color of the markers added afterwards.
+  /// \sa LeafNodeMarkerArray
+  virtual bool addMarkerArray(const std::string& markerArrayName,
+                              const std::string& shape, const Color_t& color);
+  /// Set the poses of the markers, whose number becomes the number of poses.
+  virtual bool setMarkerArrayPoses(const std::string& markerArrayName,
+                                   const std::vector<Configuration>& poses);
+  /// \param scales one scale per marker.
+  virtual bool setMarkerArrayScales(const std::string& markerArrayName,
+                                    const std::vector<osgVector3>& scales);
+  /// \param colors one color per marker.
+  virtual bool setMarkerArrayColors(const std::string& markerArrayName,
+                                    const std::vector<Color_t>& colors);
+
   virtual bool addSquareFace(const std::string& faceName,
                              const osgVector3& pos1, const osgVector3& pos2,
                              const osgVector3& pos3, const osgVector3& pos4,
@@ -243,6 +324,17 @@ class WindowsManager {
   virtual bool removeFromGroup(const std::string& nodeName,
                                const std::string& groupName);
   virtual bool deleteNode(const std::string& nodeName, bool all);
+  /// Delete several nodes at once.
+  ///
+  /// The nodes are removed from the scene under a single lock of
+  /// osgFrameMutex(). Their OSG objects are released afterwards, by a
+  /// background thread.
+  /// \param all whether to also delete the descendants of the groups.
+  /// \return false if none of the nodes exists.
+  virtual bool deleteNodes(const std::vector<std::string>& nodeNames,
+                           bool all);
+  /// Delete all the descendants of a group, and keep the group.
+  virtual bool clearGroup(const std::string& groupName);
 
   virtual bool removeObjectFromCache(const std::string& nodeName);
   virtual bool applyConfiguration(const std::string& nodeName,
@@ -304,6 +396,20 @@ class WindowsManager {
   template <typename Property_t>
   void setProperty(const std::string& nodeName, const std::string& propName,
                    const Property_t& value);
+  /// Set the property \c propNames[i] of node \c nodeNames[i] to
+  /// \c values[i].
+  ///
+  /// The frame mutex is locked once for the whole batch. The editors are
+  /// notified once per modified property, after all the values are set.
+  /// Nothing is modified if a node or a property does not exist, or if a
+  /// property is read-only. If a value is rejected, the values set before
+  /// are kept and notified, and std::invalid_argument is thrown.
+  /// \param propNames either one property name per node or a single name,
+  ///        used for all the nodes.
+  template <typename Property_t>
+  void setProperties(const std::vector<std::string>& nodeNames,
+                     const std::vector<std::string>& propNames,
+                     const std::vector<Property_t>& values);
 
   virtual std::string getStringProperty(const std::string& nodeName,
                                         const std::string& propName) const;
@@ -341,6 +447,49 @@ class WindowsManager {
   virtual void callVoidProperty(const std::string& nodeName,
                                 const std::string& propName);
 
+  virtual void setStringProperties(const std::vector<std::string>& nodeNames,
+                                   const std::vector<std::string>& propNames,
+                                   const std::vector<std::string>& values);
+  virtual void setVector2Properties(const std::vector<std::string>& nodeNames,
+                                    const std::vector<std::string>& propNames,
+                                    const std::vector<osgVector2>& values);
+  virtual void setVector3Properties(const std::vector<std::string>& nodeNames,
+                                    const std::vector<std::string>& propNames,
+                                    const std::vector<osgVector3>& values);
+  virtual void setColorProperties(const std::vector<std::string>& nodeNames,
+                                  const std::vector<std::string>& propNames,
+                                  const std::vector<osgVector4>& values);
+  virtual void setFloatProperties(const std::vector<std::string>& nodeNames,
+                                  const std::vector<std::string>& propNames,
+                                  const std::vector<float>& values);
+  virtual void setBoolProperties(const std::vector<std::string>& nodeNames,
+                                 const std::vector<std::string>& propNames,
+                                 const std::vector<bool>& values);
+  virtual void setIntProperties(const std::vector<std::string>& nodeNames,
+                                const std::vector<std::string>& propNames,
+                                const std::vector<int>& values);
+
+  /// Memory used by a node and by its descendants.
+  /// \sa MemoryUsageVisitor
+  virtual MemoryUsage getNodeMemoryUsage(const std::string& nodeName);
+  /// Memory used by the whole scene of a window.
+  /// \sa MemoryUsageVisitor
+  virtual MemoryUsage getWindowMemoryUsage(const WindowID windowId);
+
+  /// Number of drawn and culled drawables of a window during the last frame.
+  /// The culling is configured with the \c Camera properties of the window.
+  /// \sa WindowManager::getCullingStatistics
+  virtual CullingStatistics getCullingStatistics(const WindowID windowId);
+
+  /// Cast rays against the selectable nodes below a node, in parallel.
+  /// The scene is locked during the call.
+  /// \param maxDistance rays longer than this distance hit nothing.
+  /// \return the nearest hit of each ray.
+  /// \sa RayCaster
+  virtual std::vector<RayHit> castRays(
+      const std::string& nodeName, const std::vector<osgVector3>& origins,
+      const std::vector<osgVector3>& directions, const float maxDistance);
+
   WindowManagerPtr_t getWindowManager(const WindowID wid,
                                       bool throwIfDoesntExist = false) const;
   GroupNodePtr_t getGroup(const std::string groupName,
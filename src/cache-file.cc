@@ -0,0 +1,85 @@
+//
+//  cache-file.cc
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include "cache-file.hh"
+
+#include <sys/stat.h>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <cstdlib>
+#include <iomanip>
+#include <osgDB/FileNameUtils>
+#include <osgDB/FileUtils>
+#include <sstream>
+
+#include "log.hh"
+
+namespace gepetto {
+namespace viewer {
+namespace {
+OpenThreads::Mutex mutex;
+
+/// FNV-1a hash, which does not change between runs.
+unsigned long long hash(const std::string& s) {
+  unsigned long long h = 14695981039346656037ULL;
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    h ^= (unsigned char)s[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/// Create the cache directory, once.
+/// \return an empty string if it cannot be created.
+const std::string& cacheDirectory() {
+  static bool created = false;
+  static std::string dir;
+  if (created) return dir;
+  created = true;
+
+  const char* xdg = std::getenv("XDG_CACHE_HOME");
+  const char* home = std::getenv("HOME");
+  if (xdg != NULL && *xdg != '\0')
+    dir = std::string(xdg) + "/gepetto-viewer";
+  else if (home != NULL && *home != '\0')
+    dir = std::string(home) + "/.cache/gepetto-viewer";
+  if (!dir.empty() && !osgDB::makeDirectory(dir)) {
+    log() << "Could not create the cache directory " << dir << std::endl;
+    dir.clear();
+  }
+  return dir;
+}
+}  // namespace
+
+std::string cacheFileName(const std::string& source,
+                          const std::string& suffix) {
+  struct stat sourceStat;
+  if (stat(source.c_str(), &sourceStat) != 0) return std::string();
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  const std::string& dir = cacheDirectory();
+  if (dir.empty()) return std::string();
+
+  std::ostringstream key;
+  key << osgDB::getRealPath(source) << '\n' << (long long)sourceStat.st_mtime;
+  std::ostringstream name;
+  name << dir << '/' << osgDB::getSimpleFileName(source) << '-' << std::hex
+       << std::setw(16) << std::setfill('0') << hash(key.str()) << suffix;
+  return name.str();
+}
+
+void logCacheWriteFailure(const std::string& file) {
+  static bool logged = false;
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  if (logged) return;
+  logged = true;
+  log() << "Could not write " << file
+        << ". Other cache files may not be written either." << std::endl;
+}
+
+} /* namespace viewer */
+} /* namespace gepetto */
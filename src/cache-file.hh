@@ -0,0 +1,33 @@
+//
+//  cache-file.hh
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#ifndef GEPETTO_VIEWER_CACHE_FILE_HH
+#define GEPETTO_VIEWER_CACHE_FILE_HH
+
+#include <gepetto/viewer/config.hh>
+#include <string>
+
+namespace gepetto {
+namespace viewer {
+
+/// Name of the file caching data computed from \c source, in the cache
+/// directory of the user (\c $XDG_CACHE_HOME/gepetto-viewer, or
+/// \c ~/.cache/gepetto-viewer). The name depends on the path and on the
+/// modification time of \c source, so an outdated file is never used.
+/// \param suffix appended to the name, e.g. \c ".dds".
+/// \return an empty string if \c source or the directory are not available.
+std::string cacheFileName(const std::string& source,
+                          const std::string& suffix) GEPETTO_VIEWER_LOCAL;
+
+/// Log that a cache file could not be written. Only the first failure is
+/// logged.
+void logCacheWriteFailure(const std::string& file) GEPETTO_VIEWER_LOCAL;
+
+} /* namespace viewer */
+} /* namespace gepetto */
+
+#endif /* GEPETTO_VIEWER_CACHE_FILE_HH */
@@ -0,0 +1,233 @@
+//
+//  camera-sensor.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/camera-sensor.h>
+
+#include <gepetto/viewer/node.h>
+
+#include <cmath>
+#include <osg/Geometry>
+#include <osg/LightSource>
+#include <osg/Program>
+#include <osg/Texture>
+#include <stdexcept>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+const char* pointVertexShader =
+    "void main() {\n"
+    "  gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "  gl_Position = ftransform();\n"
+    "}\n";
+
+// The depth buffer value d of a point at distance z along the optical axis
+// is far * (z - near) / (z * (far - near)).
+const char* pointFragmentShader =
+    "uniform sampler2D gv_depth;\n"
+    "uniform vec2 gv_range;\n"
+    "uniform vec2 gv_tanHalfFov;\n"
+    "void main() {\n"
+    "  vec2 uv = gl_TexCoord[0].xy;\n"
+    "  float d = texture2D(gv_depth, uv).r;\n"
+    "  if (d >= 1.0) {\n"
+    "    gl_FragColor = vec4(0.0);\n"
+    "    return;\n"
+    "  }\n"
+    "  float n = gv_range.x, f = gv_range.y;\n"
+    "  float z = n * f / (f - d * (f - n));\n"
+    "  vec2 xy = (2.0 * uv - 1.0) * gv_tanHalfFov * z;\n"
+    "  gl_FragColor = vec4(xy.x, -xy.y, z, 1.0);\n"
+    "}\n";
+
+/// The optical frame of the sensor is the OpenGL eye frame turned upside
+/// down.
+const osg::Matrix eyeToOptical = osg::Matrix::rotate(osg::PI, 1., 0., 0.);
+}  // namespace
+
+CameraSensor::CameraSensor(const std::string& name, const NodePtr_t& node,
+                           const unsigned int& width,
+                           const unsigned int& height, const float& fovy,
+                           const float& zNear, const float& zFar)
+    : name_(name),
+      node_(node),
+      width_(width),
+      height_(height),
+      rate_(0),
+      frame_count_(0),
+      last_tick_(0),
+      rendering_(false),
+      scene_(NULL) {
+  if (!node) throw std::invalid_argument("The sensor needs a node");
+  if (width == 0 || height == 0)
+    throw std::invalid_argument("The sensor resolution must not be zero");
+  if (!(fovy > 0 && fovy < osg::PI))
+    throw std::invalid_argument("The field of view must be in ]0, pi[");
+  if (!(zNear > 0 && zFar > zNear))
+    throw std::invalid_argument("The range must satisfy 0 < zNear < zFar");
+
+  root_ = new osg::Group;
+  root_->setName(name);
+  root_->setNodeMask(0x0);
+  createColorCamera(fovy, zNear, zFar);
+  createPointCamera(fovy, zNear, zFar);
+}
+
+void CameraSensor::createColorCamera(const float& fovy, const float& zNear,
+                                     const float& zFar) {
+  color_image_ = new osg::Image;
+  color_image_->allocateImage((int)width_, (int)height_, 1, GL_RGBA,
+                              GL_UNSIGNED_BYTE);
+
+  depth_texture_ = new osg::Texture2D;
+  depth_texture_->setTextureSize((int)width_, (int)height_);
+  depth_texture_->setInternalFormat(GL_DEPTH_COMPONENT24);
+  depth_texture_->setSourceFormat(GL_DEPTH_COMPONENT);
+  depth_texture_->setSourceType(GL_FLOAT);
+  depth_texture_->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+  depth_texture_->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+  depth_texture_->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+  depth_texture_->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+
+  color_camera_ = new osg::Camera;
+  color_camera_->setName(name_ + "_color");
+  color_camera_->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+  color_camera_->setRenderOrder(osg::Camera::PRE_RENDER, 0);
+  color_camera_->setRenderTargetImplementation(
+      osg::Camera::FRAME_BUFFER_OBJECT);
+  color_camera_->setViewport(0, 0, (int)width_, (int)height_);
+  color_camera_->setProjectionMatrixAsPerspective(
+      osg::RadiansToDegrees(fovy), (double)width_ / (double)height_, zNear,
+      zFar);
+  // The depth buffer is converted with the given range.
+  color_camera_->setComputeNearFarMode(
+      osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR);
+  color_camera_->setCullMask(VisibilityBit);
+  color_camera_->setClearMask(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  color_camera_->setClearColor(osg::Vec4(0.f, 0.f, 0.f, 0.f));
+  color_camera_->setAllowEventFocus(false);
+  color_camera_->attach(osg::Camera::COLOR_BUFFER, color_image_.get());
+  color_camera_->attach(osg::Camera::DEPTH_BUFFER, depth_texture_.get());
+
+  // The light of the window follows the main camera. The sensor has its own
+  // head light.
+  osg::ref_ptr<osg::LightSource> light = new osg::LightSource;
+  light->setReferenceFrame(osg::LightSource::ABSOLUTE_RF);
+  light->getLight()->setLightNum(0);
+  light->getLight()->setPosition(osg::Vec4(0.f, 0.f, 1.f, 0.f));
+  light->setStateSetModes(*color_camera_->getOrCreateStateSet(),
+                          osg::StateAttribute::ON);
+  color_camera_->addChild(light);
+
+  root_->addChild(color_camera_);
+}
+
+void CameraSensor::createPointCamera(const float& fovy, const float& zNear,
+                                     const float& zFar) {
+  point_image_ = new osg::Image;
+  point_image_->allocateImage((int)width_, (int)height_, 1, GL_RGBA,
+                              GL_FLOAT);
+  point_image_->setInternalTextureFormat(GL_RGBA32F_ARB);
+
+  // Draw a quad covering the viewport, which samples the depth buffer.
+  point_camera_ = new osg::Camera;
+  point_camera_->setName(name_ + "_points");
+  point_camera_->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+  point_camera_->setRenderOrder(osg::Camera::PRE_RENDER, 1);
+  point_camera_->setRenderTargetImplementation(
+      osg::Camera::FRAME_BUFFER_OBJECT);
+  point_camera_->setViewport(0, 0, (int)width_, (int)height_);
+  point_camera_->setProjectionMatrixAsOrtho2D(0., 1., 0., 1.);
+  point_camera_->setViewMatrix(osg::Matrix::identity());
+  point_camera_->setClearMask(GL_COLOR_BUFFER_BIT);
+  point_camera_->setClearColor(osg::Vec4(0.f, 0.f, 0.f, 0.f));
+  point_camera_->setAllowEventFocus(false);
+  point_camera_->attach(osg::Camera::COLOR_BUFFER, point_image_.get());
+  point_camera_->getBufferAttachmentMap()[osg::Camera::COLOR_BUFFER]
+      ._internalFormat = GL_RGBA32F_ARB;
+
+  osg::ref_ptr<osg::Geode> quad = new osg::Geode;
+  quad->addDrawable(osg::createTexturedQuadGeometry(
+      osg::Vec3(0.f, 0.f, 0.f), osg::Vec3(1.f, 0.f, 0.f),
+      osg::Vec3(0.f, 1.f, 0.f)));
+  point_camera_->addChild(quad);
+
+  osg::ref_ptr<osg::Program> program = new osg::Program;
+  program->setName("gv_pointCloud");
+  program->addShader(new osg::Shader(osg::Shader::VERTEX, pointVertexShader));
+  program->addShader(
+      new osg::Shader(osg::Shader::FRAGMENT, pointFragmentShader));
+
+  const float tanHalfFovy = std::tan(fovy / 2);
+  osg::StateSet* ss = quad->getOrCreateStateSet();
+  ss->setAttributeAndModes(program, osg::StateAttribute::ON);
+  ss->setTextureAttributeAndModes(0, depth_texture_, osg::StateAttribute::ON);
+  ss->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+  ss->setMode(GL_BLEND, osg::StateAttribute::OFF);
+  ss->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+  ss->addUniform(new osg::Uniform("gv_depth", 0));
+  ss->addUniform(new osg::Uniform("gv_range", osg::Vec2(zNear, zFar)));
+  ss->addUniform(new osg::Uniform(
+      "gv_tanHalfFov",
+      osg::Vec2(tanHalfFovy * (float)width_ / (float)height_, tanHalfFovy)));
+
+  root_->addChild(point_camera_);
+}
+
+CameraSensorPtr_t CameraSensor::create(const std::string& name,
+                                       const NodePtr_t& node,
+                                       const unsigned int& width,
+                                       const unsigned int& height,
+                                       const float& fovy, const float& zNear,
+                                       const float& zFar) {
+  return CameraSensorPtr_t(
+      new CameraSensor(name, node, width, height, fovy, zNear, zFar));
+}
+
+osg::Group* CameraSensor::setScene(osg::Group* scene) {
+  if (scene_ != NULL) color_camera_->removeChild(scene_);
+  scene_ = scene;
+  color_camera_->addChild(scene_);
+  return root_.get();
+}
+
+bool CameraSensor::prepareFrame(const osg::Timer_t& tick) {
+  rendering_ = false;
+  NodePtr_t node = node_.lock();
+  if (node && scene_ != NULL &&
+      (rate_ <= 0 ||
+       osg::Timer::instance()->delta_s(last_tick_, tick) >= 1. / rate_)) {
+    // The pose of the node in the scene rendered by the sensor, without its
+    // scale.
+    osg::MatrixList matrices =
+        node->asQueue()->getWorldMatrices(scene_);
+    if (!matrices.empty()) {
+      const osg::Matrix& world = matrices.front();
+      osg::Matrix pose = osg::Matrix::rotate(world.getRotate()) *
+                         osg::Matrix::translate(world.getTrans());
+      color_camera_->setViewMatrix(osg::Matrix::inverse(pose) *
+                                   eyeToOptical);
+      last_tick_ = tick;
+      rendering_ = true;
+    }
+  }
+  root_->setNodeMask(rendering_ ? VisibilityBit : 0x0);
+  return rendering_;
+}
+
+void CameraSensor::frameDone() {
+  if (!rendering_) return;
+  ++frame_count_;
+  if (callback_) callback_(*this);
+}
+
+CameraSensor::~CameraSensor() {
+  while (root_->getNumParents() > 0)
+    root_->getParent(0)->removeChild(root_);
+}
+} /* namespace viewer */
+} /* namespace gepetto */
@@ -0,0 +1,323 @@
+//
+//  frozen-geometry.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/frozen-geometry.h>
+
+#include <algorithm>
+#include <osg/AutoTransform>
+#include <osg/Billboard>
+#include <osg/Camera>
+#include <osg/NodeVisitor>
+#include <osg/TriangleIndexFunctor>
+#include <osg/Version>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+const std::string noNode;
+
+struct CollectTriangles {
+  std::vector<unsigned int> indices;
+
+  void operator()(unsigned int i1, unsigned int i2, unsigned int i3) {
+    indices.push_back(i1);
+    indices.push_back(i2);
+    indices.push_back(i3);
+  }
+};
+
+bool isTriangleMode(GLenum mode) {
+  switch (mode) {
+    case GL_TRIANGLES:
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_QUADS:
+    case GL_QUAD_STRIP:
+    case GL_POLYGON:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Whether the array has either one element per vertex or a single element
+/// for all the vertices.
+bool perVertexOrOverall(const osg::Array* array, unsigned int numVertices) {
+  if (array->getBinding() == osg::Array::BIND_OFF ||
+      array->getBinding() == osg::Array::BIND_PER_PRIMITIVE_SET)
+    return false;
+  return array->getNumElements() == 1 ||
+         array->getNumElements() >= numVertices;
+}
+
+bool canMerge(const osg::Geometry& geom) {
+  const osg::Vec3Array* vertices =
+      dynamic_cast<const osg::Vec3Array*>(geom.getVertexArray());
+  if (vertices == NULL) return false;
+  unsigned int n = vertices->getNumElements();
+
+  const osg::Array* normals = geom.getNormalArray();
+  if (normals != NULL &&
+      (dynamic_cast<const osg::Vec3Array*>(normals) == NULL ||
+       !perVertexOrOverall(normals, n)))
+    return false;
+  const osg::Array* colors = geom.getColorArray();
+  if (colors != NULL &&
+      (dynamic_cast<const osg::Vec4Array*>(colors) == NULL ||
+       !perVertexOrOverall(colors, n)))
+    return false;
+  if (geom.getSecondaryColorArray() != NULL || geom.getFogCoordArray() != NULL)
+    return false;
+  for (unsigned int i = 0; i < geom.getNumTexCoordArrays(); ++i) {
+    const osg::Array* texCoords = geom.getTexCoordArray(i);
+    if (texCoords == NULL) continue;
+    if (i > 0 || dynamic_cast<const osg::Vec2Array*>(texCoords) == NULL ||
+        texCoords->getNumElements() < n)
+      return false;
+  }
+  for (unsigned int i = 0; i < geom.getNumVertexAttribArrays(); ++i)
+    if (geom.getVertexAttribArray(i) != NULL) return false;
+  for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i) {
+    const osg::PrimitiveSet* primitives = geom.getPrimitiveSet(i);
+    // Instanced primitives are drawn at several places.
+    if (!isTriangleMode(primitives->getMode()) ||
+        primitives->getNumInstances() != 0)
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+/// Collect the visible geometries of a subgraph, with their transform, their
+/// state and the name of the node they belong to.
+class FreezeVisitor : public osg::NodeVisitor {
+ public:
+  /// \param builder NULL to only check whether the subgraph can be frozen.
+  FreezeVisitor(FrozenGeometry::Builder* builder)
+      : osg::NodeVisitor(TRAVERSE_ACTIVE_CHILDREN),
+        builder_(builder),
+        ok_(true) {
+    setTraversalMask(VisibilityBit);
+    matrices_.push_back(osg::Matrix::identity());
+  }
+
+  bool ok() const { return ok_; }
+
+  void apply(osg::Node& node) {
+    if (!ok_) return;
+    push(node);
+    traverse(node);
+    pop(node);
+  }
+
+  void apply(osg::Transform& transform) {
+    if (!ok_) return;
+    // The transform of these nodes depends on the view.
+    if (transform.getReferenceFrame() != osg::Transform::RELATIVE_RF ||
+        dynamic_cast<osg::Camera*>(&transform) != NULL ||
+        dynamic_cast<osg::AutoTransform*>(&transform) != NULL) {
+      ok_ = false;
+      return;
+    }
+    osg::Matrix matrix(matrices_.back());
+    transform.computeLocalToWorldMatrix(matrix, this);
+    matrices_.push_back(matrix);
+    apply(static_cast<osg::Node&>(transform));
+    matrices_.pop_back();
+  }
+
+  void apply(osg::Billboard&) { ok_ = false; }
+
+  void apply(osg::Geode& geode) {
+    if (!ok_) return;
+    push(geode);
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i)
+      add(geode.getDrawable(i));
+    pop(geode);
+  }
+
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 3, 2)
+  void apply(osg::Drawable& drawable) {
+    if (ok_) add(&drawable);
+  }
+#endif
+
+ private:
+  FrozenGeometry::Builder* builder_;
+  bool ok_;
+  std::vector<osg::Matrix> matrices_;
+  std::vector<const osg::StateSet*> stateSets_;
+  std::vector<std::string> names_;
+
+  void push(osg::Node& node) {
+    stateSets_.push_back(node.getStateSet());
+    if (node.getNodeMask() & NodeBit) names_.push_back(node.getName());
+  }
+
+  void pop(osg::Node& node) {
+    stateSets_.pop_back();
+    if (node.getNodeMask() & NodeBit) names_.pop_back();
+  }
+
+  void add(osg::Drawable* drawable) {
+    const osg::Geometry* geom = drawable->asGeometry();
+    if (geom == NULL || !canMerge(*geom)) {
+      ok_ = false;
+      return;
+    }
+    if (builder_ == NULL) return;
+
+    osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+    for (std::size_t i = 0; i < stateSets_.size(); ++i)
+      if (stateSets_[i] != NULL) stateSet->merge(*stateSets_[i]);
+    if (geom->getStateSet() != NULL) stateSet->merge(*geom->getStateSet());
+    bool normals = geom->getNormalArray() != NULL;
+    bool colors = geom->getColorArray() != NULL;
+    bool texCoords = geom->getTexCoordArray(0) != NULL;
+
+    std::vector<osg::ref_ptr<FrozenGeometry> >& geometries =
+        builder_->geometries_;
+    std::size_t i = 0;
+    while (i < geometries.size() &&
+           !geometries[i]->accepts(stateSet, normals, colors, texCoords))
+      ++i;
+    if (i == geometries.size())
+      geometries.push_back(
+          new FrozenGeometry(stateSet, normals, colors, texCoords));
+    geometries[i]->add(*geom, matrices_.back(),
+                       names_.empty() ? noNode : names_.back());
+  }
+};
+
+FrozenGeometry::FrozenGeometry(osg::StateSet* stateSet, bool normals,
+                               bool colors, bool texCoords)
+    : vertices_(new osg::Vec3Array),
+      triangles_(new osg::DrawElementsUInt(GL_TRIANGLES)) {
+  setName("frozenGeometry");
+  setDataVariance(osg::Object::STATIC);
+  setUseDisplayList(false);
+  setUseVertexBufferObjects(true);
+  setStateSet(stateSet);
+
+  setVertexArray(vertices_);
+  if (normals) {
+    normals_ = new osg::Vec3Array;
+    setNormalArray(normals_, osg::Array::BIND_PER_VERTEX);
+  }
+  if (colors) {
+    colors_ = new osg::Vec4Array;
+    setColorArray(colors_, osg::Array::BIND_PER_VERTEX);
+  }
+  if (texCoords) {
+    texCoords_ = new osg::Vec2Array;
+    setTexCoordArray(0, texCoords_);
+  }
+  addPrimitiveSet(triangles_);
+}
+
+bool FrozenGeometry::accepts(const osg::StateSet* stateSet, bool normals,
+                             bool colors, bool texCoords) const {
+  return normals == normals_.valid() && colors == colors_.valid() &&
+         texCoords == texCoords_.valid() &&
+         getStateSet()->compare(*stateSet, true) == 0;
+}
+
+void FrozenGeometry::add(const osg::Geometry& geom, const osg::Matrix& matrix,
+                         const std::string& node) {
+  osg::TriangleIndexFunctor<CollectTriangles> collect;
+  geom.accept(collect);
+  if (collect.indices.empty()) return;
+
+  const osg::Vec3Array* vertices =
+      static_cast<const osg::Vec3Array*>(geom.getVertexArray());
+  unsigned int first = (unsigned int)vertices_->size();
+  unsigned int n = (unsigned int)vertices->size();
+  Range range = {first, (unsigned int)(triangles_->size() / 3), node};
+  ranges_.push_back(range);
+
+  for (unsigned int i = 0; i < n; ++i)
+    vertices_->push_back((*vertices)[i] * matrix);
+  if (normals_) {
+    const osg::Vec3Array* normals =
+        static_cast<const osg::Vec3Array*>(geom.getNormalArray());
+    // Normals are transformed by the inverse transpose of the matrix.
+    osg::Matrix inverse = osg::Matrix::inverse(matrix);
+    bool overall = normals->size() < n;
+    for (unsigned int i = 0; i < n; ++i) {
+      osg::Vec3 normal =
+          osg::Matrix::transform3x3(inverse, (*normals)[overall ? 0 : i]);
+      normal.normalize();
+      normals_->push_back(normal);
+    }
+    normals_->dirty();
+  }
+  if (colors_) {
+    const osg::Vec4Array* colors =
+        static_cast<const osg::Vec4Array*>(geom.getColorArray());
+    bool overall = colors->size() < n;
+    for (unsigned int i = 0; i < n; ++i)
+      colors_->push_back((*colors)[overall ? 0 : i]);
+    colors_->dirty();
+  }
+  if (texCoords_) {
+    const osg::Vec2Array* texCoords =
+        static_cast<const osg::Vec2Array*>(geom.getTexCoordArray(0));
+    texCoords_->insert(texCoords_->end(), texCoords->begin(),
+                       texCoords->begin() + n);
+    texCoords_->dirty();
+  }
+
+  // A mirroring transform reverses the orientation of the triangles.
+  osg::Vec3d x(matrix(0, 0), matrix(0, 1), matrix(0, 2)),
+      y(matrix(1, 0), matrix(1, 1), matrix(1, 2)),
+      z(matrix(2, 0), matrix(2, 1), matrix(2, 2));
+  bool flip = (x ^ y) * z < 0;
+  const std::vector<unsigned int>& indices = collect.indices;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    triangles_->push_back(first + indices[i]);
+    triangles_->push_back(first + indices[flip ? i + 2 : i + 1]);
+    triangles_->push_back(first + indices[flip ? i + 1 : i + 2]);
+  }
+  vertices_->dirty();
+  triangles_->dirty();
+  dirtyBound();
+}
+
+const std::string& FrozenGeometry::nodeAtTriangle(unsigned int index) const {
+  std::vector<Range>::const_iterator it =
+      std::upper_bound(ranges_.begin(), ranges_.end(), index, beforeTriangle);
+  if (it == ranges_.begin()) return noNode;
+  return (--it)->node;
+}
+
+const std::string& FrozenGeometry::nodeAtVertex(unsigned int index) const {
+  std::vector<Range>::const_iterator it =
+      std::upper_bound(ranges_.begin(), ranges_.end(), index, beforeVertex);
+  if (it == ranges_.begin()) return noNode;
+  return (--it)->node;
+}
+
+bool FrozenGeometry::Builder::canFreeze(osg::Node* root) {
+  FreezeVisitor visitor(NULL);
+  root->accept(visitor);
+  return visitor.ok();
+}
+
+void FrozenGeometry::Builder::add(osg::Node* root) {
+  FreezeVisitor visitor(this);
+  root->accept(visitor);
+}
+
+osg::ref_ptr<osg::Geode> FrozenGeometry::Builder::geode() const {
+  osg::ref_ptr<osg::Geode> geode = new osg::Geode;
+  geode->setName("frozenGeometries");
+  for (std::size_t i = 0; i < geometries_.size(); ++i)
+    geode->addDrawable(geometries_[i]);
+  return geode;
+}
+} /* namespace viewer */
+} /* namespace gepetto */
@@ -6,17 +6,80 @@
 //  Copyright (c) 2014 LAAS-CNRS. All rights reserved.
 //
 
+#include <gepetto/viewer/frozen-geometry.h>
 #include <gepetto/viewer/group-node.h>
+#include <gepetto/viewer/leaf-node-collada.h>
+#include <gepetto/viewer/mesh-instancer.h>
+
+#include <algorithm>
 
 namespace gepetto {
 namespace viewer {
+namespace {
+struct CollectMeshes : public NodeVisitor {
+  std::vector<LeafNodeColladaPtr_t> meshes;
+
+  void apply(GroupNode& group) {
+    // This group is responsible of its own instancing.
+    if (group.getInstancing()) return;
+    NodeVisitor::apply(group);
+  }
+
+  void apply(LeafNodeCollada& mesh) { meshes.push_back(mesh.self()); }
+};
+
+typedef std::unordered_map<const ::osg::Node*, std::size_t> OsgNodeCounts_t;
+
+/// Decrement the count of a node, if any.
+bool take(OsgNodeCounts_t& counts, const ::osg::Node* node) {
+  OsgNodeCounts_t::iterator it = counts.find(node);
+  if (it == counts.end()) return false;
+  if (--it->second == 0) counts.erase(it);
+  return true;
+}
+
+/// Remove the roots of children from a group in a single pass, by runs of
+/// consecutive nodes.
+void removeRoots(::osg::Group* queue, OsgNodeCounts_t& roots) {
+  for (unsigned int i = queue->getNumChildren(); i > 0;) {
+    const unsigned int last = i;
+    while (i > 0 && take(roots, queue->getChild(i - 1))) --i;
+    if (i < last)
+      queue->removeChildren(i, last - i);
+    else
+      --i;
+  }
+}
+}  // namespace
+
+/// Recompute the instanced meshes of a group once its children changed.
+struct GroupNode::UpdateInstancing : public ::osg::NodeCallback {
+  GroupNode* group;
+
+  UpdateInstancing(GroupNode* g) : group(g) {}
+
+  void operator()(::osg::Node* node, ::osg::NodeVisitor* nv) {
+    if (group->instancing_dirty_) group->updateInstancing();
+    traverse(node, nv);
+  }
+};
 
 /* Declaration of private function members */
 
 GroupNode::GroupNode(const std::string& name)
-    : Node(name), list_of_objects_() {}
+    : Node(name),
+      list_of_objects_(),
+      instancing_(false),
+      instancing_dirty_(false) {
+  init();
+}
 
-GroupNode::GroupNode(const GroupNode& other) : Node(other), list_of_objects_() {
+GroupNode::GroupNode(const GroupNode& other)
+    : Node(other),
+      list_of_objects_(),
+      instancing_(false),
+      instancing_dirty_(false) {
+  init();
   size_t i;
   for (i = 0; i < other.getNumOfChildren(); i++) {
     addChild(other.getChild(i));
@@ -27,6 +90,33 @@ void GroupNode::initWeakPtr(GroupNodeWeakPtr other_weak_ptr) {
   weak_ptr_ = other_weak_ptr;
 }
 
+void GroupNode::init() {
+  instancers_ = new ::osg::Group;
+  instancers_->setName("instancers");
+  instancers_->setUpdateCallback(new UpdateInstancing(this));
+
+  addProperty(BoolProperty::create("Instancing", this,
+                                   &GroupNode::getInstancing,
+                                   &GroupNode::setInstancing));
+  addProperty(VoidProperty::create(
+      "UpdateInstancing",
+      VoidProperty::memberFunction(this, &GroupNode::updateInstancing)));
+  addProperty(BoolProperty::create("Frozen", this, &GroupNode::getFrozen,
+                                   &GroupNode::setFrozen));
+}
+
+void GroupNode::clearInstancers() {
+  for (unsigned int i = 0; i < instancers_->getNumChildren(); ++i)
+    static_cast<MeshInstancer*>(instancers_->getChild(i))->clear();
+  instancers_->removeChildren(0, instancers_->getNumChildren());
+}
+
+void GroupNode::indexChildren() {
+  child_positions_.clear();
+  for (std::size_t i = 0; i < list_of_objects_.size(); ++i)
+    child_positions_[list_of_objects_[i].get()].push_back(i);
+}
+
 /* End of declaration of private function members */
 
 /* Declaration of protected function members */
@@ -59,31 +149,123 @@ GroupNodePtr_t GroupNode::clone(void) const {
 GroupNodePtr_t GroupNode::self(void) const { return weak_ptr_.lock(); }
 
 bool GroupNode::addChild(NodePtr_t child_ptr) {
+  child_positions_[child_ptr.get()].push_back(list_of_objects_.size());
   list_of_objects_.push_back(child_ptr);
   this->asQueue()->addChild(child_ptr->asGroup());
+  if (instancing_) instancing_dirty_ = true;
   setDirty();
   return true;
 }
 
 bool GroupNode::removeChild(NodePtr_t child_ptr) {
-  Nodes_t::iterator it =
-      std::find(list_of_objects_.begin(), list_of_objects_.end(), child_ptr);
-  if (it != list_of_objects_.end()) list_of_objects_.erase(it);
-  bool removed = this->asQueue()->removeChild(
-      this->asQueue()->getChildIndex(child_ptr->asGroup()));
-  if (removed) setDirty();
-  return removed;
+  ChildPositions_t::iterator positions =
+      child_positions_.find(child_ptr.get());
+  if (positions == child_positions_.end()) return false;
+  if (getFrozen()) {
+    setFrozen(false);
+    bool removed = removeChild(child_ptr);
+    setFrozen(true);
+    return removed;
+  }
+  const std::size_t pos = positions->second.back();
+  positions->second.pop_back();
+  if (positions->second.empty()) child_positions_.erase(positions);
+
+  // Move the last child in place of the removed one, in list_of_objects_
+  // and, when it mirrors it, in the OSG group.
+  ::osg::Group* queue = this->asQueue();
+  ::osg::GroupRefPtr root = child_ptr->asGroup();
+  const std::size_t last = list_of_objects_.size() - 1;
+  const bool mirrored =
+      queue->getNumChildren() == list_of_objects_.size() &&
+      queue->getChild((unsigned int)pos) == root.get() &&
+      queue->getChild((unsigned int)last) ==
+          list_of_objects_.back()->asGroup().get();
+  if (pos != last) {
+    std::vector<std::size_t>& moved =
+        child_positions_[list_of_objects_.back().get()];
+    *std::find(moved.begin(), moved.end(), last) = pos;
+    list_of_objects_[pos].swap(list_of_objects_.back());
+    if (mirrored)
+      queue->setChild((unsigned int)pos, queue->getChild((unsigned int)last));
+  }
+  list_of_objects_.pop_back();
+  if (mirrored)
+    queue->removeChildren((unsigned int)last, 1);
+  else
+    queue->removeChild(root);
+
+  if (instancing_) instancing_dirty_ = true;
+  setDirty();
+  return true;
+}
+
+bool GroupNode::removeChildren(size_t pos, size_t num) {
+  if (pos >= list_of_objects_.size() || num == 0) return false;
+  if (getFrozen()) {
+    setFrozen(false);
+    bool removed = removeChildren(pos, num);
+    setFrozen(true);
+    return removed;
+  }
+  num = std::min(num, list_of_objects_.size() - pos);
+  const Nodes_t::iterator begin = list_of_objects_.begin() + (long)pos;
+  const Nodes_t::iterator end = begin + (long)num;
+
+  OsgNodeCounts_t roots;
+  for (Nodes_t::iterator it = begin; it != end; ++it)
+    ++roots[(*it)->asGroup().get()];
+  list_of_objects_.erase(begin, end);
+  indexChildren();
+
+  removeRoots(this->asQueue(), roots);
+  if (instancing_) instancing_dirty_ = true;
+  setDirty();
+  return true;
+}
+
+bool GroupNode::removeChildren(const std::set<const Node*>& children) {
+  std::set<const Node*>::const_iterator child = children.begin();
+  while (child != children.end() && child_positions_.count(*child) == 0)
+    ++child;
+  if (child == children.end()) return false;
+  if (getFrozen()) {
+    setFrozen(false);
+    bool removed = removeChildren(children);
+    setFrozen(true);
+    return removed;
+  }
+  OsgNodeCounts_t roots;
+  Nodes_t::iterator kept = list_of_objects_.begin();
+  for (Nodes_t::iterator it = list_of_objects_.begin();
+       it != list_of_objects_.end(); ++it) {
+    if (children.count(it->get()) == 0) {
+      if (kept != it) kept->swap(*it);
+      ++kept;
+      continue;
+    }
+    ++roots[(*it)->asGroup().get()];
+  }
+  list_of_objects_.erase(kept, list_of_objects_.end());
+  indexChildren();
+
+  removeRoots(this->asQueue(), roots);
+  if (instancing_) instancing_dirty_ = true;
+  setDirty();
+  return true;
 }
 
 bool GroupNode::hasChild(NodePtr_t child_ptr) const {
-  Nodes_t::const_iterator it =
-      std::find(list_of_objects_.begin(), list_of_objects_.end(), child_ptr);
-  return it != list_of_objects_.end();
+  return child_positions_.count(child_ptr.get()) > 0;
 }
 
 void GroupNode::removeAllChildren() {
+  clearInstancers();
   list_of_objects_.clear();
+  child_positions_.clear();
   this->asQueue()->removeChild(0, this->asQueue()->getNumChildren());
+  frozen_children_ = NULL;
+  frozen_geode_ = NULL;
   setDirty();
 }
 
@@ -123,6 +305,78 @@ void GroupNode::setColor(const osgVector4& color) {
   }
 }
 
+void GroupNode::setInstancing(bool instancing) {
+  instancing_ = instancing;
+  updateInstancing();
+}
+
+void GroupNode::updateInstancing() {
+  clearInstancers();
+  instancing_dirty_ = false;
+  setDirty();
+  // The instanced meshes of a frozen group are merged.
+  if (!instancing_ || getFrozen()) return;
+  if (this->asQueue()->getChildIndex(instancers_) ==
+      this->asQueue()->getNumChildren())
+    this->asQueue()->addChild(instancers_);
+
+  CollectMeshes collect;
+  traverse(collect);
+
+  std::vector<MeshInstancerRefPtr> instancers;
+  for (std::size_t i = 0; i < collect.meshes.size(); ++i) {
+    const LeafNodeColladaPtr_t& mesh = collect.meshes[i];
+    if (!MeshInstancer::canInstance(mesh)) continue;
+    std::size_t j = 0;
+    while (j < instancers.size() && !instancers[j]->accepts(mesh)) ++j;
+    if (j < instancers.size())
+      instancers[j]->addInstance(mesh);
+    else
+      instancers.push_back(new MeshInstancer(mesh));
+  }
+  for (std::size_t j = 0; j < instancers.size(); ++j) {
+    // A single instance is better drawn by its own node.
+    if (instancers[j]->getNumInstances() > 1)
+      instancers_->addChild(instancers[j]);
+    else
+      instancers[j]->clear();
+  }
+}
+
+void GroupNode::setFrozen(bool frozen) {
+  if (frozen == getFrozen()) return;
+  if (frozen) {
+    clearInstancers();
+    frozen_children_ = new ::osg::Group;
+    frozen_children_->setName("frozenChildren");
+    // The original children are neither drawn nor intersected.
+    frozen_children_->setNodeMask(0x0);
+
+    FrozenGeometry::Builder builder;
+    for (Nodes_t::iterator it = list_of_objects_.begin();
+         it != list_of_objects_.end(); ++it) {
+      ::osg::GroupRefPtr root = (*it)->asGroup();
+      if (!FrozenGeometry::Builder::canFreeze(root)) continue;
+      builder.add(root);
+      frozen_children_->addChild(root);
+      this->asQueue()->removeChild(root);
+    }
+    frozen_geode_ = builder.geode();
+    frozen_geode_->setNodeMask(VisibilityBit | IntersectionBit);
+    this->asQueue()->addChild(frozen_geode_);
+    this->asQueue()->addChild(frozen_children_);
+  } else {
+    for (unsigned int i = 0; i < frozen_children_->getNumChildren(); ++i)
+      this->asQueue()->addChild(frozen_children_->getChild(i));
+    this->asQueue()->removeChild(frozen_geode_);
+    this->asQueue()->removeChild(frozen_children_);
+    frozen_children_ = NULL;
+    frozen_geode_ = NULL;
+    updateInstancing();
+  }
+  setDirty();
+}
+
 void GroupNode::traverse(NodeVisitor& visitor) {
   Nodes_t::iterator iter_list_of_objects;
   for (iter_list_of_objects = list_of_objects_.begin();
@@ -135,7 +389,10 @@ osg::ref_ptr<osg::Node> GroupNode::getOsgNode() const {
   return this->asQueue();
 }
 
-GroupNode::~GroupNode() { removeAllChildren(); }
+GroupNode::~GroupNode() {
+  instancers_->setUpdateCallback(NULL);
+  removeAllChildren();
+}
 
 /* End of declaration of public function members */
 
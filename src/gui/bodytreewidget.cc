@@ -17,6 +17,7 @@
 #include <QApplication>
 #include <QHBoxLayout>
 #include <QSignalMapper>
+#include <QTimer>
 #include <gepetto/gui/bodytreewidget.hh>
 #include <gepetto/gui/mainwindow.hh>
 #include <gepetto/gui/node-action.hh>
@@ -24,9 +25,44 @@
 #include <gepetto/gui/selection-event.hh>
 #include <gepetto/gui/tree-item.hh>
 #include <gepetto/gui/windows-manager.hh>
+#include <gepetto/viewer/memory-usage-visitor.h>
 
 namespace gepetto {
 namespace gui {
+namespace {
+QString formatBytes(std::size_t bytes) {
+  static const char* units[] = {"B", "KiB", "MiB", "GiB"};
+  double value = static_cast<double>(bytes);
+  int unit = 0;
+  while (value >= 1024. && unit < 3) {
+    value /= 1024.;
+    ++unit;
+  }
+  return QString::number(value, 'f', unit == 0 ? 0 : 1) + " " + units[unit];
+}
+
+void setMemoryUsageColumn(QStandardItem* parent,
+                          const viewer::MemoryUsageVisitor& visitor) {
+  for (int i = 0; i < parent->rowCount(); ++i) {
+    BodyTreeItem* item = dynamic_cast<BodyTreeItem*>(parent->child(i, 0));
+    if (!item) continue;
+    const viewer::MemoryUsage& usage = visitor.usage(*item->node());
+    QStandardItem* column =
+        new QStandardItem(formatBytes(usage.subtreeCpuBytes) + " / " +
+                          formatBytes(usage.subtreeGpuBytes) + " GPU");
+    column->setToolTip(
+        QString("Node alone: %1 / %2 GPU\nWith descendants: %3 / %4 GPU")
+            .arg(formatBytes(usage.cpuBytes))
+            .arg(formatBytes(usage.gpuBytes))
+            .arg(formatBytes(usage.subtreeCpuBytes))
+            .arg(formatBytes(usage.subtreeGpuBytes)));
+    column->setEditable(false);
+    parent->setChild(i, 1, column);
+    setMemoryUsageColumn(item, visitor);
+  }
+}
+}  // namespace
+
 void BodyTreeWidget::init(QTreeView* view, QWidget* propertyArea) {
   MainWindow* main = MainWindow::instance();
   osg_ = main->osg();
@@ -105,14 +141,28 @@ void BodyTreeWidget::emitBodySelected(SelectionEvent* event) {
 }
 
 void BodyTreeWidget::updatePropertyArea(BodyTreeItem* item) {
+  propertyItem_ = item;
+  if (propertyAreaUpdatePending_) return;
+  propertyAreaUpdatePending_ = true;
+  QTimer::singleShot(0, this, SLOT(doUpdatePropertyArea()));
+}
+
+void BodyTreeWidget::doUpdatePropertyArea() {
+  propertyAreaUpdatePending_ = false;
+  QWidget* editors = propertyItem_ ? propertyItem_->propertyEditors() : NULL;
+  QLayout* layout = propertyArea_->layout();
+  // The editors of the item are already shown.
+  if (layout->count() == 1 && layout->itemAt(0)->widget() == editors) return;
+
   QLayoutItem* child;
-  while ((child = propertyArea_->layout()->takeAt(0)) != 0) {
+  while ((child = layout->takeAt(0)) != 0) {
     if (child->widget() != NULL) {
       child->widget()->setParent(NULL);
     }
+    delete child;
   }
-  if (item != NULL) {
-    propertyArea_->layout()->addWidget(item->propertyEditors());
+  if (editors != NULL) {
+    layout->addWidget(editors);
   }
 }
 
@@ -145,6 +195,19 @@ QList<BodyTreeItem*> BodyTreeWidget::selectedBodies() const {
   return list;
 }
 
+void BodyTreeWidget::showMemoryUsage() {
+  viewer::MemoryUsageVisitor visitor;
+  {
+    viewer::ScopedLock lock(osg_->osgFrameMutex());
+    for (int i = 0; i < model_->rowCount(); ++i) {
+      BodyTreeItem* item = dynamic_cast<BodyTreeItem*>(model_->item(i));
+      if (item) item->node()->accept(visitor);
+    }
+  }
+  setMemoryUsageColumn(model_->invisibleRootItem(), visitor);
+  view_->resizeColumnToContents(0);
+}
+
 void BodyTreeWidget::customContextMenu(const QPoint& pos) {
   QModelIndex index = view_->indexAt(pos);
   if (index.isValid()) {
@@ -160,6 +223,8 @@ void BodyTreeWidget::customContextMenu(const QPoint& pos) {
           new NodeAction(w->objectName(), item->node(), w, windows);
       windows->addAction(ja);
     }
+    contextMenu.addAction(tr("Show memory usage"), this,
+                          SLOT(showMemoryUsage()));
     contextMenu.exec(view_->mapToGlobal(pos));
   }
 }
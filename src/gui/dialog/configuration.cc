@@ -241,7 +241,7 @@ void constructor_hook(ConfigurationDialog*,
     pyValue->setReadOnly(true);                                                \
                                                                                \
     QFormLayout* layout = new QFormLayout;                                     \
-    layout->addRow(new QLabel(property->objectName()));                        \
+    layout->addRow(new QLabel(QString::fromStdString(property->name())));     \
                                                                                \
     spinBoxes.reserve(N);                                                      \
     for (int i = 0; i < N; ++i) {                                              \
@@ -237,6 +237,8 @@ bool PluginManager::loadPyPlugin(const QString& name) {
 bool PluginManager::unloadPyPlugin(const QString& name) {
   MainWindow* main = MainWindow::instance();
 #if GEPETTO_GUI_HAS_PYTHONQT
+  // Without interpreter, no plugin is loaded. Do not start it.
+  if (!main->hasPythonWidget()) return true;
   PythonWidget* pw = main->pythonWidget();
   pw->unloadModulePlugin(name);
   return true;
@@ -252,7 +254,7 @@ bool PluginManager::unloadPyPlugin(const QString& name) {
 bool PluginManager::isPyPluginLoaded(const QString& name) {
 #if GEPETTO_GUI_HAS_PYTHONQT
   MainWindow* main = MainWindow::instance();
-  if (!main) return false;
+  if (!main || !main->hasPythonWidget()) return false;
   PythonWidget* pw = main->pythonWidget();
   return pw->hasPlugin(name);
 #else
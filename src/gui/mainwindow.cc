@@ -61,14 +61,17 @@ MainWindow::MainWindow(Settings* settings, QWidget* parent)
   MainWindow::instance_ = this;
   ui_->setupUi(this);
 
-  // Setup the body tree view
-  osgViewerManagers_ = WindowsManager::create(ui_->bodyTreeContent);
-  ui_->bodyTreeContent->init(ui_->bodyTree, ui_->propertyArea);
-
-  // This scene contains elements required for User Interaction.
-  osg()->createScene("gepetto-gui");
-  // TODO remove me. This is kept for backward compatibility
-  osg()->createScene("hpp-gui");
+  {
+    StartupPhase phase(settings_, "OSG initialization");
+    // Setup the body tree view
+    osgViewerManagers_ = WindowsManager::create(ui_->bodyTreeContent);
+    ui_->bodyTreeContent->init(ui_->bodyTree, ui_->propertyArea);
+
+    // This scene contains elements required for User Interaction.
+    osg()->createScene("gepetto-gui");
+    // TODO remove me. This is kept for backward compatibility
+    osg()->createScene("hpp-gui");
+  }
 
   // Setup the main OSG widget
   connect(ui_->actionRefresh, SIGNAL(triggered()), SLOT(requestRefresh()));
@@ -76,7 +79,8 @@ MainWindow::MainWindow(Settings* settings, QWidget* parent)
   collisionLabel_ = new QLabel("No collisions.");
   shortcutFactory_ = new ShortcutFactory;
 #if GEPETTO_GUI_HAS_PYTHONQT
-  pythonWidget_ = new PythonWidget(this);
+  pythonWidget_ = NULL;
+  pythonConsoleAction_ = NULL;
 #endif
   setupInterface();
   connect(ui_->actionChange_shortcut, SIGNAL(triggered()), shortcutFactory_,
@@ -92,8 +96,10 @@ MainWindow::MainWindow(Settings* settings, QWidget* parent)
 MainWindow::~MainWindow() {
   delete shortcutFactory_;
 #if GEPETTO_GUI_HAS_PYTHONQT
-  removeDockWidget(pythonWidget_);
-  delete pythonWidget_;
+  if (pythonWidget_ != NULL) {
+    removeDockWidget(pythonWidget_);
+    delete pythonWidget_;
+  }
 #endif
   pluginManager()->clearPlugins();
   osgViewerManagers_.reset();
@@ -104,6 +110,40 @@ MainWindow::~MainWindow() {
 
 MainWindow* MainWindow::instance() { return instance_; }
 
+#if GEPETTO_GUI_HAS_PYTHONQT
+PythonWidget* MainWindow::pythonWidget() {
+  if (pythonWidget_ == NULL) createPythonWidget();
+  return pythonWidget_;
+}
+
+void MainWindow::createPythonWidget() {
+  {
+    StartupPhase phase(settings_, "Python interpreter");
+    pythonWidget_ = new PythonWidget(this);
+  }
+  insertDockWidget(pythonWidget_, Qt::BottomDockWidgetArea, Qt::Horizontal);
+  registerShortcut("Python console", "Toggle view",
+                   pythonWidget_->toggleViewAction());
+  if (pythonConsoleAction_ != NULL) {
+    // The window state was restored without the Python console.
+    ui_->menuWindow->removeAction(pythonConsoleAction_);
+    pythonConsoleAction_->deleteLater();
+    pythonConsoleAction_ = NULL;
+    settings_->restoreDockWidgetsState();
+    settings_->restorePythonHistory();
+  }
+}
+
+void MainWindow::showPythonWidget() { pythonWidget()->show(); }
+#endif
+
+void MainWindow::loadPlugins() {
+  settings_->loadPlugins();
+  // Dock widgets added by plugins were not there when the state was restored.
+  settings_->restoreDockWidgetsState();
+  settings_->traceStartupDone();
+}
+
 void MainWindow::insertDockWidget(QDockWidget* dock, Qt::DockWidgetArea area,
                                   Qt::Orientation orientation) {
   addDockWidget(area, dock, orientation);
@@ -459,9 +499,13 @@ void MainWindow::setupInterface() {
                                                        Qt::Key_L);
   ui_->menuWindow->addAction(ui_->dockWidget_log->toggleViewAction());
 #if GEPETTO_GUI_HAS_PYTHONQT
-  insertDockWidget(pythonWidget_, Qt::BottomDockWidgetArea, Qt::Horizontal);
-  registerShortcut("Python console", "Toggle view",
-                   pythonWidget_->toggleViewAction());
+  if (settings_->deferPlugins) {
+    pythonConsoleAction_ = ui_->menuWindow->addAction(
+        QIcon::fromTheme("window-new"), "&PythonQt console");
+    connect(pythonConsoleAction_, SIGNAL(triggered()),
+            SLOT(showPythonWidget()));
+  } else
+    createPythonWidget();
 #endif
 
   // Add QActions to split dock widgets
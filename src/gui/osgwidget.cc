@@ -94,6 +94,8 @@ OSGWidget::OSGWidget(WindowsManagerPtr_t wm, const std::string& name,
   hblayout->addWidget(toolBar_);
   hblayout->addWidget(glWidget);
   glWidget->setMinimumSize(50, 10);
+  // Mouse moves are needed to highlight the node under the cursor.
+  glWidget->setMouseTracking(true);
 
   // TODO Adding the properties here is problematic. They won't be
   // shown in the GUI because the display is created before this code is run.
@@ -16,7 +16,9 @@
 
 #include "gepetto/gui/pick-handler.hh"
 
+#include <gepetto/viewer/frozen-geometry.h>
 #include <gepetto/viewer/node.h>
+#include <gepetto/viewer/window-manager.h>
 
 #include <QApplication>
 #include <QDebug>
@@ -40,6 +42,11 @@
 
 namespace gepetto {
 namespace gui {
+namespace {
+/// Highlight state of the node under the cursor.
+const unsigned int hoverHighlightState = 2;
+}  // namespace
+
 PickHandler::PickHandler(OSGWidget* parent, WindowsManagerPtr_t wsm)
     : osgGA::GUIEventHandler(),
       wsm_(wsm),
@@ -81,6 +88,9 @@ bool PickHandler::handle(const osgGA::GUIEventAdapter& ea,
       }
       return false;
       break;
+    case osgGA::GUIEventAdapter::MOVE:
+      hover(ea.getX(), ea.getY());
+      return false;
     case osgGA::GUIEventAdapter::KEYUP:
       switch (ea.getKey()) {
         case 'z':
@@ -107,6 +117,22 @@ void PickHandler::getUsage(osg::ApplicationUsage& usage) const {
   usage.addKeyboardMouseBinding('z', "Move camera on selected node");
   usage.addKeyboardMouseBinding('Z', "Move and zoom on selected node");
   usage.addKeyboardMouseBinding('f', "Center view to mouse");
+  usage.addKeyboardMouseBinding("Mouse move",
+                                "Highlight node under cursor (id picking)");
+}
+
+void PickHandler::hover(const float& x, const float& y) {
+  viewer::WindowManagerPtr_t window = parent_->window();
+  NodePtr_t n;
+  if (window && window->getIdPicking()) n = window->getNodeAt(x, y);
+  NodePtr_t previous = hovered_.lock();
+  if (n == previous) return;
+  // Do not override the highlight of the selection.
+  if (previous && previous->getHighlightState() == hoverHighlightState)
+    previous->setHighlightState(0);
+  if (n && n->getHighlightState() == 0)
+    n->setHighlightState(hoverHighlightState);
+  hovered_ = n;
 }
 
 void PickHandler::computeLineIntersection(osgGA::GUIActionAdapter& aa,
@@ -166,9 +192,31 @@ PickHandler::LineSegmentIntersector PickHandler::computeLineOrPointIntersection(
 void PickHandler::selectionNodeUnderCursor(osgGA::GUIActionAdapter& aa,
                                            const float& x, const float& y,
                                            int modKeyMask) {
-  LineSegmentIntersector li = computeLineOrPointIntersection(aa, x, y);
   BodyTreeWidget* bt = MainWindow::instance()->bodyTree();
 
+  // The id buffer gives the node without intersecting the scene.
+  viewer::WindowManagerPtr_t window = parent_->window();
+  if (window && window->getIdPicking()) {
+    NodePtr_t n = window->getNodeAt(x, y);
+    if (n) {
+      // The node is no longer hovered but selected.
+      if (n == hovered_.lock() &&
+          n->getHighlightState() == hoverHighlightState)
+        n->setHighlightState(0);
+      hovered_.reset();
+      bt->emitBodySelected(new SelectionEvent(
+          SelectionEvent::FromOsgWindow, n, mapper_.getQtModKey(modKeyMask)));
+      QStatusBar* statusBar = MainWindow::instance()->statusBar();
+      statusBar->clearMessage();
+      statusBar->showMessage(QString::fromStdString(n->getID()));
+    } else
+      bt->emitBodySelected(new SelectionEvent(
+          SelectionEvent::FromOsgWindow, QApplication::keyboardModifiers()));
+    return;
+  }
+
+  LineSegmentIntersector li = computeLineOrPointIntersection(aa, x, y);
+
   if (!li || !li->containsIntersections()) {
     bt->emitBodySelected(new SelectionEvent(SelectionEvent::FromOsgWindow,
                                             QApplication::keyboardModifiers()));
@@ -179,26 +227,35 @@ void PickHandler::selectionNodeUnderCursor(osgGA::GUIActionAdapter& aa,
   // intersector->getIntersections();
   const osgUtil::LineSegmentIntersector::Intersection& intersection =
       li->getFirstIntersection();
-  for (int i = (int)intersection.nodePath.size() - 1; i >= 0; --i) {
+  bool pointIntersection = osg::dynamic_pointer_cast<PointIntersector>(li);
+  NodePtr_t n;
+  // The merged geometries of a frozen group know the original nodes.
+  const viewer::FrozenGeometry* frozen =
+      dynamic_cast<const viewer::FrozenGeometry*>(intersection.drawable.get());
+  if (frozen) {
+    unsigned int index = intersection.primitiveIndex;
+    n = wsm_->getNode(pointIntersection ? frozen->nodeAtVertex(index)
+                                        : frozen->nodeAtTriangle(index));
+  }
+  for (int i = (int)intersection.nodePath.size() - 1; !n && i >= 0; --i) {
     if (!(intersection.nodePath[i]->getNodeMask() & viewer::NodeBit)) continue;
-    NodePtr_t n = wsm_->getNode(intersection.nodePath[i]->getName());
-    if (n) {
-      SelectionEvent* event = new SelectionEvent(
-          SelectionEvent::FromOsgWindow, n, mapper_.getQtModKey(modKeyMask));
-      event->setupIntersection(intersection);
-      bt->emitBodySelected(event);
-
-      QStatusBar* statusBar = MainWindow::instance()->statusBar();
-      statusBar->clearMessage();
-      if (osg::dynamic_pointer_cast<PointIntersector>(li))
-        statusBar->showMessage(QString::fromStdString(n->getID()) +
-                               QString(" - Vectex index: ") +
-                               QString::number(intersection.primitiveIndex));
-      else
-        statusBar->showMessage(QString::fromStdString(n->getID()));
-      return;
-    }
+    n = wsm_->getNode(intersection.nodePath[i]->getName());
   }
+  if (!n) return;
+
+  SelectionEvent* event = new SelectionEvent(SelectionEvent::FromOsgWindow, n,
+                                             mapper_.getQtModKey(modKeyMask));
+  event->setupIntersection(intersection);
+  bt->emitBodySelected(event);
+
+  QStatusBar* statusBar = MainWindow::instance()->statusBar();
+  statusBar->clearMessage();
+  if (pointIntersection)
+    statusBar->showMessage(QString::fromStdString(n->getID()) +
+                           QString(" - Vectex index: ") +
+                           QString::number(intersection.primitiveIndex));
+  else
+    statusBar->showMessage(QString::fromStdString(n->getID()));
 }
 
 void PickHandler::centerViewToMouse(osgGA::GUIActionAdapter& aa, const float& x,
@@ -16,11 +16,14 @@
 
 #include "../../src/gui/python-bindings.hh"
 
+#include <gepetto/viewer/leaf-node-marker-array.h>
+#include <gepetto/viewer/window-manager.h>
 #include <gepetto/viewer/windows-manager.h>
 
 #include <boost/python.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 #include <gepetto/gui/windows-manager.hh>
+#include <stdexcept>
 
 namespace bp = boost::python;
 namespace gv = gepetto::viewer;
@@ -51,6 +54,12 @@ struct to_python_converters {
     return bp::incref(bp::make_tuple(v[0], v[1], v[2], v[3]).ptr());
   }
 
+  static PyObject* convert(const std::vector<gv::RayHit>& v) {
+    bp::list l;
+    for (std::size_t i = 0; i < v.size(); ++i) l.append(v[i]);
+    return bp::incref(l.ptr());
+  }
+
   static PyObject* convert(const gv::Configuration& v) {
     return bp::incref(bp::make_tuple(v.position[0], v.position[1],
                                      v.position[2], v.quat[0], v.quat[1],
@@ -59,6 +68,121 @@ struct to_python_converters {
   }
 };
 
+/// Copy of the data of an image. The image is overwritten each time it is
+/// rendered, so it must be copied with the frame mutex held.
+bp::object imageBytes(const osg::Image* image) {
+  PyObject* bytes = PyBytes_FromStringAndSize(
+      reinterpret_cast<const char*>(image->data()),
+      (Py_ssize_t)image->getTotalSizeInBytes());
+  return bp::object(bp::handle<>(bytes));
+}
+
+bp::object getCameraSensorColor(gv::WindowsManager& wsm,
+                                const std::string& sensorName,
+                                const std::string& windowId) {
+  gv::CameraSensorPtr_t sensor = wsm.getCameraSensor(sensorName, windowId);
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  return imageBytes(sensor->getColorImage());
+}
+
+bp::object getCameraSensorPoints(gv::WindowsManager& wsm,
+                                 const std::string& sensorName,
+                                 const std::string& windowId) {
+  gv::CameraSensorPtr_t sensor = wsm.getCameraSensor(sensorName, windowId);
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  return imageBytes(sensor->getPointImage());
+}
+
+std::size_t getCameraSensorFrameCount(gv::WindowsManager& wsm,
+                                      const std::string& sensorName,
+                                      const std::string& windowId) {
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  return wsm.getCameraSensor(sensorName, windowId)->getFrameCount();
+}
+
+/// Rows of floats read from a contiguous buffer, such as a numpy array,
+/// without copy when the buffer already holds floats.
+class FloatRows {
+ public:
+  FloatRows(const bp::object& obj, std::size_t width) : data_(NULL), num_(0) {
+    if (PyObject_GetBuffer(obj.ptr(), &view_,
+                           PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+      PyErr_Clear();
+      throw std::invalid_argument("Expected a contiguous array");
+    }
+    std::string format(view_.format == NULL ? "B" : view_.format);
+    if (!format.empty() && std::string("@=<").find(format[0]) !=
+                               std::string::npos)
+      format.erase(0, 1);
+    std::size_t size = 0;
+    if (format == "f") {
+      size = (std::size_t)view_.len / sizeof(float);
+      data_ = static_cast<const float*>(view_.buf);
+    } else if (format == "d") {
+      size = (std::size_t)view_.len / sizeof(double);
+      const double* d = static_cast<const double*>(view_.buf);
+      copy_.assign(d, d + size);
+      data_ = copy_.data();
+    } else {
+      PyBuffer_Release(&view_);
+      throw std::invalid_argument("Expected an array of float32 or float64");
+    }
+    if (size % width != 0) {
+      PyBuffer_Release(&view_);
+      throw std::invalid_argument("Wrong number of columns");
+    }
+    num_ = size / width;
+  }
+
+  ~FloatRows() { PyBuffer_Release(&view_); }
+
+  const float* data() const { return data_; }
+  std::size_t rows() const { return num_; }
+
+ private:
+  Py_buffer view_;
+  std::vector<float> copy_;
+  const float* data_;
+  std::size_t num_;
+};
+
+gv::LeafNodeMarkerArrayPtr_t getMarkerArray(gv::WindowsManager& wsm,
+                                            const std::string& name) {
+  gv::LeafNodeMarkerArrayPtr_t markers =
+      gv::dynamic_pointer_cast<gv::LeafNodeMarkerArray>(
+          wsm.getNode(name, true));
+  if (!markers)
+    throw std::invalid_argument("Node " + name + " is not a marker array");
+  return markers;
+}
+
+bool setMarkerArrayPoses(gv::WindowsManager& wsm, const std::string& name,
+                         const bp::object& poses) {
+  gv::LeafNodeMarkerArrayPtr_t markers = getMarkerArray(wsm, name);
+  FloatRows rows(poses, 7);
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  markers->setPoses(rows.data(), rows.rows());
+  return true;
+}
+
+bool setMarkerArrayScales(gv::WindowsManager& wsm, const std::string& name,
+                          const bp::object& scales) {
+  gv::LeafNodeMarkerArrayPtr_t markers = getMarkerArray(wsm, name);
+  FloatRows rows(scales, 3);
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  markers->setScales(rows.data(), rows.rows());
+  return true;
+}
+
+bool setMarkerArrayColors(gv::WindowsManager& wsm, const std::string& name,
+                          const bp::object& colors) {
+  gv::LeafNodeMarkerArrayPtr_t markers = getMarkerArray(wsm, name);
+  FloatRows rows(colors, 4);
+  gv::ScopedLock lock(wsm.osgFrameMutex());
+  markers->setColors(rows.data(), rows.rows());
+  return true;
+}
+
 template <typename V>
 inline void set(V& v, int i, const double& d) {
   v[i] = (float)d;
@@ -78,28 +202,34 @@ struct from_python_converters {
   }
 
   // Determine if obj_ptr can be converted in a QString
+  // Only sequences are accepted: iterating over an iterator would consume
+  // it before construct.
   static void* convertible(PyObject* obj_ptr) {
-    if (!PyIter_Check(obj_ptr)) return 0;
-    PyObject* iterator = PyObject_GetIter(obj_ptr);
-    PyObject* item;
+    if (!PySequence_Check(obj_ptr) || PyUnicode_Check(obj_ptr) ||
+        PyBytes_Check(obj_ptr))
+      return 0;
+    if (PySequence_Size(obj_ptr) != N) {
+      PyErr_Clear();
+      return 0;
+    }
     for (int i = 0; i < N; ++i) {
-      item = PyIter_Next(iterator);
+      PyObject* item = PySequence_GetItem(obj_ptr, i);
       if (item == NULL) {
-        Py_DECREF(iterator);
+        PyErr_Clear();
         return 0;
       }
-      bool isFloat = PyFloat_Check(item);
-      Py_DECREF(item);
-      if (!isFloat) {
-        Py_DECREF(iterator);
-        return 0;
+      // Accept numpy scalars as well as Python floats, as long as they
+      // convert to a float.
+      bool isFloat = PyFloat_Check(item) || PyNumber_Check(item);
+      if (isFloat) {
+        PyFloat_AsDouble(item);
+        if (PyErr_Occurred()) {
+          PyErr_Clear();
+          isFloat = false;
+        }
       }
-    }
-    item = PyIter_Next(iterator);
-    Py_DECREF(iterator);
-    if (item != NULL) {
       Py_DECREF(item);
-      return 0;
+      if (!isFloat) return 0;
     }
     return obj_ptr;
   }
@@ -119,19 +249,73 @@ struct from_python_converters {
 
     V& value(*(V*)storage);
 
-    PyObject* iterator = PyObject_GetIter(obj_ptr);
     for (int i = 0; i < N; ++i) {
-      PyObject* item = PyIter_Next(iterator);
+      PyObject* item = PySequence_GetItem(obj_ptr, i);
       set(value, i, PyFloat_AsDouble(item));
       Py_DECREF(item);
     }
-    Py_DECREF(iterator);
 
     // Stash the memory chunk pointer for later use by boost.python
     data->convertible = storage;
   }
 };
 
+/// Convert a Python sequence (list, tuple, numpy array...) into a
+/// std::vector<T>, each item being converted to T. Iterators and generators
+/// are not accepted, as checking their items would consume them.
+template <typename T>
+struct from_python_vector_converters {
+  typedef std::vector<T> Vector_t;
+
+  from_python_vector_converters() {
+    boost::python::converter::registry::push_back(
+        &convertible, &construct, boost::python::type_id<Vector_t>());
+  }
+
+  static void* convertible(PyObject* obj_ptr) {
+    // Strings are iterable but should not be split into characters.
+    if (!PySequence_Check(obj_ptr) || PyUnicode_Check(obj_ptr) ||
+        PyBytes_Check(obj_ptr))
+      return 0;
+    Py_ssize_t size = PySequence_Size(obj_ptr);
+    if (size < 0) {
+      PyErr_Clear();
+      return 0;
+    }
+    bool ok = true;
+    for (Py_ssize_t i = 0; ok && i < size; ++i) {
+      PyObject* item = PySequence_GetItem(obj_ptr, i);
+      if (item == NULL) {
+        PyErr_Clear();
+        return 0;
+      }
+      ok = bp::extract<T>(item).check();
+      Py_DECREF(item);
+    }
+    return ok ? obj_ptr : 0;
+  }
+
+  static void construct(
+      PyObject* obj_ptr,
+      boost::python::converter::rvalue_from_python_stage1_data* data) {
+    void* storage =
+        ((boost::python::converter::rvalue_from_python_storage<Vector_t>*)
+             data)
+            ->storage.bytes;
+    Vector_t* vector = new (storage) Vector_t;
+
+    Py_ssize_t size = PySequence_Size(obj_ptr);
+    vector->reserve((std::size_t)size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+      PyObject* item = PySequence_GetItem(obj_ptr, i);
+      vector->push_back(bp::extract<T>(item));
+      Py_DECREF(item);
+    }
+
+    data->convertible = storage;
+  }
+};
+
 void exposeOSG() {
   bp::class_<std::vector<std::string> >("string_vector")
       .def(bp::vector_indexing_suite<std::vector<std::string> >());
@@ -142,13 +326,43 @@ void exposeOSG() {
   from_python_converters<osgVector3, 3>();
   from_python_converters<osgQuat, 4>();
   from_python_converters<gv::Configuration, 7>();
+  from_python_converters<osgVector2, 2>();
+  from_python_converters<osgVector4, 4>();
+
+  from_python_vector_converters<std::string>();
+  from_python_vector_converters<float>();
+  from_python_vector_converters<bool>();
+  from_python_vector_converters<int>();
+  from_python_vector_converters<osgVector2>();
+  from_python_vector_converters<osgVector3>();
+  from_python_vector_converters<osgVector4>();
 }
 
 void exposeGV() {
   typedef gepetto::viewer::WindowsManager WindowsManager;
 
-  bp::class_<WindowsManager, noncopyable>("WindowsManagerBase", bp::no_init) GV_DEF(
-      getNodeList) GV_DEF(getGroupNodeList) GV_DEF(getSceneList) GV_DEF(getWindowList)
+  bp::class_<gv::MemoryUsage>("MemoryUsage")
+      .def_readonly("cpuBytes", &gv::MemoryUsage::cpuBytes)
+      .def_readonly("gpuBytes", &gv::MemoryUsage::gpuBytes)
+      .def_readonly("subtreeCpuBytes", &gv::MemoryUsage::subtreeCpuBytes)
+      .def_readonly("subtreeGpuBytes", &gv::MemoryUsage::subtreeGpuBytes);
+  bp::class_<gv::CullingStatistics>("CullingStatistics")
+      .def_readonly("drawn", &gv::CullingStatistics::drawn)
+      .def_readonly("culled", &gv::CullingStatistics::culled);
+  bp::class_<gv::RayHit>("RayHit")
+      .def("hit", &gv::RayHit::hit)
+      .def_readonly("distance", &gv::RayHit::distance)
+      .add_property("point", bp::make_getter(&gv::RayHit::point,
+                                             bp::return_value_policy<
+                                                 bp::return_by_value>()))
+      .add_property("normal", bp::make_getter(&gv::RayHit::normal,
+                                              bp::return_value_policy<
+                                                  bp::return_by_value>()))
+      .def_readonly("node", &gv::RayHit::node);
+  bp::to_python_converter<std::vector<gv::RayHit>, to_python_converters>();
+
+  bp::class_<WindowsManager, noncopyable>("WindowsManagerBase", bp::no_init) GV_DEF0(
+      getNodeList, std::vector<std::string>) GV_DEF1(getNodeList, std::vector<std::string>, const std::string&) GV_DEF1(getGroupNodeList, std::vector<std::string>, const std::string&) GV_DEF2(getGroupNodeList, std::vector<std::string>, const std::string&, bool) GV_DEF(getSceneList) GV_DEF(getWindowList)
 
       GV_DEF(getWindowID)
 
@@ -156,16 +370,27 @@ void exposeGV() {
               addSceneToWindow)
 
               GV_DEF(attachCameraToNode) GV_DEF(detachCamera)
+                  GV_DEF(addCameraSensor) GV_DEF(removeCameraSensor)
+                      GV_DEF(setCameraSensorRate)
+      // Copies of the buffers of the sensor, e.g.
+      // numpy.frombuffer(getCameraSensorPoints(sensor, window), numpy.float32)
+      .def("getCameraSensorColor", &getCameraSensorColor)
+      .def("getCameraSensorPoints", &getCameraSensorPoints)
+      .def("getCameraSensorFrameCount", &getCameraSensorFrameCount)
+      // numpy arrays of float32 or float64, with one marker per row.
+      .def("setMarkerArrayPoses", &setMarkerArrayPoses)
+      .def("setMarkerArrayScales", &setMarkerArrayScales)
+      .def("setMarkerArrayColors", &setMarkerArrayColors)
 
                   GV_DEF(nodeExists)
 
                       GV_DEF(addFloor) GV_DEF(addBox) GV_DEF(addCapsule) GV_DEF(resizeCapsule) GV_DEF(
-                          addArrow) GV_DEF(resizeArrow) GV_DEF(addRod) GV_DEF(addMesh) GV_DEF(removeLightSources)
+                          addArrow) GV_DEF(resizeArrow) GV_DEF(addRod) GV_DEF(applyRodConfiguration) GV_DEF2(addMesh, bool, const std::string&, const std::string&) GV_DEF3(addMesh, bool, const std::string&, const std::string&, bool) GV_DEF(removeLightSources)
                           GV_DEF(addCone) GV_DEF(addCylinder) GV_DEF(addSphere) GV_DEF(
                               addLight) GV_DEF(addLine) GV_DEF(setLineStartPoint) GV_DEF(setLineEndPoint)
                               GV_DEF(setLineExtremalPoints) GV_DEF(addCurve) GV_DEF(
                                   setCurvePoints) GV_DEF(setCurveMode) GV_DEF(setCurvePointsSubset)
-                                  GV_DEF(setCurveLineWidth) GV_DEF(addSquareFace) GV_DEF(
+                                  GV_DEF(setCurveLineWidth) GV_DEF(addTube) GV_DEF(setTubePoints) GV_DEF(setTubeRadii) GV_DEF(addMarkerArray) GV_DEF(addSquareFace) GV_DEF(
                                       setTexture) GV_DEF(addTriangleFace) GV_DEF(addXYZaxis)
 
                                       GV_DEF(createRoadmap) GV_DEF(
@@ -211,7 +436,7 @@ void exposeGV() {
                                                       GV_DEF(createGroup) GV_DEF(
                                                           addToGroup)
                                                           GV_DEF(removeFromGroup) GV_DEF(
-                                                              deleteNode)
+                                                              deleteNode) GV_DEF(deleteNodes) GV_DEF(clearGroup)
 
                                                               GV_DEF(
                                                                   applyConfiguration)
@@ -265,6 +490,14 @@ void exposeGV() {
                                                               GV_DEF(
                                                                   setIntProperty)
 
+      GV_DEF(setStringProperties) GV_DEF(setVector2Properties)
+          GV_DEF(setVector3Properties) GV_DEF(setColorProperties)
+              GV_DEF(setFloatProperties) GV_DEF(setBoolProperties)
+                  GV_DEF(setIntProperties)
+
+                      GV_DEF(getNodeMemoryUsage) GV_DEF(getWindowMemoryUsage)
+                          GV_DEF(getCullingStatistics) GV_DEF(castRays)
+
       // WindowManagerPtr_t getWindowManager (const WindowID wid, bool
       // throwIfDoesntExist = false) const; GroupNodePtr_t getGroup (const
       // std::string groupName, bool throwIfDoesntExist = false) const;
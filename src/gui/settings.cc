@@ -22,6 +22,7 @@
 #include <gepetto/gui/dialog/dialogloadrobot.hh>
 #include <gepetto/gui/mainwindow.hh>
 #include <gepetto/gui/settings.hh>
+#include <gepetto/viewer/texture-cache.h>
 #include <osg/ArgumentParser>
 #include <osg/DisplaySettings>
 
@@ -41,6 +42,8 @@ Settings::Settings(const char* installDir)
       verbose(false),
       noPlugin(false),
       useNameService(false),
+      startupTrace(false),
+      deferPlugins(false),
       refreshRate(30),
       captureDirectory(),
       captureFilename("screenshot"),
@@ -57,6 +60,7 @@ Settings::Settings(const char* installDir)
 
       ,
       mw(0) {
+  startupTimer_.start();
   QDir user(QDir::home());
   const char path[] = "Pictures/gepetto-gui";
   user.mkpath(path);
@@ -142,6 +146,14 @@ int Settings::initSettings(int argc, char* argv[]) {
   au->addCommandLineOption(
       "--use-nameservice",
       "The server will be registered to the Omni NameService");
+  au->addCommandLineOption("--startup-trace",
+                           "print the duration of each startup phase");
+  au->addCommandLineOption(
+      "--defer-plugins",
+      "load plugins after the window is shown and Python on first use");
+  au->addCommandLineOption(
+      "--texture-compression",
+      "compression of the textures: none (default), dxt or etc");
 
   // 2. Read configuration files
   if (arguments.read("-c", configurationFile) ||
@@ -171,10 +183,15 @@ int Settings::initSettings(int argc, char* argv[]) {
   autoWriteSettings =
       (arguments.read("-w") || arguments.read("--auto-write-settings"));
   bool startViewerServer = (!arguments.read("--no-viewer-server"));
+  if (arguments.read("--startup-trace")) startupTrace = true;
+  if (arguments.read("--defer-plugins")) deferPlugins = true;
   while (arguments.read("--use-nameservice", useNameService)) {
   }
 
   std::string opt;
+  if (arguments.read("--texture-compression", opt) &&
+      !viewer::TextureCache::setCompression(opt))
+    retVal = 2;
   while (arguments.read("--add-robot", opt)) addRobotFromString(opt);
   while (arguments.read("--add-env", opt)) addEnvFromString(opt);
   if (startViewerServer) {
@@ -247,18 +264,30 @@ void Settings::writeSettings() {
 }
 
 void Settings::initPlugins() {
+  if (deferPlugins)
+    QMetaObject::invokeMethod(mw, "loadPlugins", Qt::QueuedConnection);
+  else
+    loadPlugins();
+}
+
+void Settings::loadPlugins() {
   foreach (QString name, pluginsToInit_) {
+    StartupPhase phase(this, "plugin " + name);
     pluginManager_.loadPlugin(name);
     pluginManager_.initPlugin(name);
   }
   foreach (QString name, pyplugins_) {
+    StartupPhase phase(this, "Python plugin " + name);
     pluginManager_.loadPyPlugin(name);
   }
 #if GEPETTO_GUI_HAS_PYTHONQT
-  PythonWidget* pw = mw->pythonWidget();
-  // TODO Wouldn't it be better to do this later ?
-  foreach (QString fileName, pyscripts_) {
-    pw->runScript(fileName);
+  if (!pyscripts_.isEmpty()) {
+    PythonWidget* pw = mw->pythonWidget();
+    // TODO Wouldn't it be better to do this later ?
+    foreach (QString fileName, pyscripts_) {
+      StartupPhase phase(this, "Python script " + fileName);
+      pw->runScript(fileName);
+    }
   }
 #else
   foreach (QString fileName, pyscripts_) {
@@ -285,11 +314,21 @@ void Settings::restoreState() const {
         settings.value("centralWidgetVisibility", true).toBool());
     settings.endGroup();
 #if GEPETTO_GUI_HAS_PYTHONQT
-    mw->pythonWidget()->restoreHistory(settings);
+    if (mw->hasPythonWidget()) mw->pythonWidget()->restoreHistory(settings);
 #endif
   }
 }
 
+void Settings::restorePythonHistory() const {
+#if GEPETTO_GUI_HAS_PYTHONQT
+  QSettings settings(QSettings::SystemScope,
+                     QCoreApplication::organizationName(),
+                     getQSettingsFileName(stateConf));
+  if (settings.status() == QSettings::NoError && mw->hasPythonWidget())
+    mw->pythonWidget()->restoreHistory(settings);
+#endif
+}
+
 void Settings::restoreDockWidgetsState() const {
   QSettings settings(QSettings::SystemScope,
                      QCoreApplication::organizationName(),
@@ -318,13 +357,31 @@ void Settings::saveState() const {
                       mw->centralWidget()->isVisible());
     settings.endGroup();
 #if GEPETTO_GUI_HAS_PYTHONQT
-    mw->pythonWidget()->saveHistory(settings);
+    if (mw->hasPythonWidget()) mw->pythonWidget()->saveHistory(settings);
 #endif
   }
 }
 
 void Settings::setMainWindow(gepetto::gui::MainWindow* main) { mw = main; }
 
+void Settings::traceStartupDone() const {
+  if (startupTrace)
+    gepetto::log() << "Startup: done in " << startupTimer_.elapsed() << " ms"
+                   << std::endl;
+}
+
+StartupPhase::StartupPhase(const Settings* settings, const QString& name)
+    : settings_(settings), name_(name) {
+  // Settings::startupTrace may be set during this phase.
+  timer_.start();
+}
+
+StartupPhase::~StartupPhase() {
+  if (settings_->startupTrace)
+    gepetto::log() << "Startup: " << name_.toLocal8Bit().constData() << " took "
+                   << timer_.elapsed() << " ms" << std::endl;
+}
+
 std::ostream& Settings::print(std::ostream& os) {
   const char tab = '\t';
   const char nl = '\n';
@@ -351,6 +408,7 @@ std::ostream& Settings::print(std::ostream& os) {
      << "Verbose:                          " << tab << verbose << nl << tab
      << "No plugin:                        " << tab << noPlugin << nl << tab
      << "Use omni name service:            " << tab << useNameService << nl
+     << tab << "Defer plugins:                    " << tab << deferPlugins << nl
      << tab << "Refresh rate:                     " << tab << refreshRate
 
      << nl << nl << "Screen capture options:" << nl << tab
@@ -456,6 +514,7 @@ void Settings::readSettingFile() {
     }
 
     GET_PARAM(useNameService, bool, toBool);
+    GET_PARAM(deferPlugins, bool, toBool);
     env.endGroup();
 
     env.beginGroup("plugins");
@@ -550,6 +609,7 @@ void Settings::writeSettingFile() {
   env.setValue("refreshRate", refreshRate);
   env.setValue("nbMultiSamples", ds->getNumMultiSamples());
   env.setValue("useNameService", useNameService);
+  env.setValue("deferPlugins", deferPlugins);
   env.setValue("appStyle", appStyle);
   env.endGroup();
 
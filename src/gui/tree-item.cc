@@ -37,26 +37,19 @@ BodyTreeItem::BodyTreeItem(QObject* parent, NodePtr_t node)
     : QObject(parent),
       QStandardItem(QString::fromStdString(
           node->getID().substr(node->getID().find_last_of("/") + 1))),
-      node_(node) {
+      node_(node),
+      propertyEditors_(NULL) {
   setEditable(false);
 }
 
-void BodyTreeItem::initialize() {
-  connect(this, SIGNAL(requestInitialize()), SLOT(doInitialize()));
-  emit requestInitialize();
+QWidget* BodyTreeItem::propertyEditors() {
+  // Most items are never selected. Building their editors when loading a
+  // robot is wasted.
+  if (propertyEditors_ == NULL) propertyEditors_ = node_->guiEditor();
+  return propertyEditors_;
 }
 
-void BodyTreeItem::doInitialize() {
-  propertyEditors_ = node_->guiEditor();
-  BodyTreeWidget* bt = MainWindow::instance()->bodyTree();
-  if (propertyEditors_->thread() != bt->thread())
-    propertyEditors_->moveToThread(bt->thread());
-  disconnect(SIGNAL(requestInitialize()));
-}
-
-BodyTreeItem::~BodyTreeItem() {
-  if (propertyEditors_->parent() != NULL) delete propertyEditors_;
-}
+BodyTreeItem::~BodyTreeItem() { delete propertyEditors_; }
 
 QStandardItem* BodyTreeItem::clone() const {
   return new BodyTreeItem(QObject::parent(), node_);
@@ -25,6 +25,8 @@
 #include "gepetto/gui/osgwidget.hh"
 #include "gepetto/gui/tree-item.hh"
 
+#include <algorithm>
+
 namespace gepetto {
 namespace gui {
 using viewer::ScopedLock;
@@ -70,12 +72,17 @@ WindowsManager::WindowID WindowsManager::createWindow(
 }
 
 WindowsManager::WindowsManager(BodyTreeWidget* bodyTree)
-    : Parent_t(), bodyTree_(bodyTree), refreshIsSynchronous_(false) {}
+    : Parent_t(),
+      bodyTree_(bodyTree),
+      refreshIsSynchronous_(false),
+      appendingItems_(false) {}
 
 void WindowsManager::addNode(const std::string& nodeName, NodePtr_t node,
                              GroupNodePtr_t parent) {
   Parent_t::addNode(nodeName, node, parent);
-  if (parent) initParent(node, parent, false);
+  if (!parent) return;
+  ScopedLock lock(nodeItemMapMtx_);
+  initParent(node, parent, false);
 }
 
 void WindowsManager::insertNode(const std::string& nodeName, NodePtr_t node) {
@@ -86,6 +93,7 @@ void WindowsManager::insertNode(const std::string& nodeName, NodePtr_t node) {
 void WindowsManager::addGroup(const std::string& groupName,
                               GroupNodePtr_t group, GroupNodePtr_t parent) {
   Parent_t::addGroup(groupName, group, parent);
+  ScopedLock lock(nodeItemMapMtx_);
   if (!parent || !initParent(group, parent, true)) {
     // Consider it a root group
     BodyTreeItem* bti = new BodyTreeItem(NULL, group);
@@ -93,8 +101,7 @@ void WindowsManager::addGroup(const std::string& groupName,
     nodeItemMap_[groupName].second = true;
     if (bti->thread() != bodyTree_->thread())
       bti->moveToThread(bodyTree_->thread());
-    bti->initialize();
-    bodyTree_->model()->appendRow(bti);
+    appendItem(NULL, bti);
   }
 }
 
@@ -109,8 +116,7 @@ void WindowsManager::addToGroup(const std::string& nodeName,
     bti->setParentGroup(groupName);
     if (bti->thread() != bodyTree_->thread())
       bti->moveToThread(bodyTree_->thread());
-    bti->initialize();
-    groups[i]->appendRow(bti);
+    appendItem(groups[i], bti);
   }
 }
 
@@ -125,6 +131,7 @@ bool WindowsManager::addToGroup(const std::string& nodeName,
       isGroup = false;
     }
     assert(node);
+    ScopedLock lock(nodeItemMapMtx_);
     BodyTreeItemMap_t::const_iterator _groups = nodeItemMap_.find(groupName);
     assert(_groups != nodeItemMap_.end());
     assert(!_groups->second.first.empty());
@@ -140,6 +147,7 @@ bool WindowsManager::removeFromGroup(const std::string& nodeName,
                                      const std::string& groupName) {
   bool ret = Parent_t::removeFromGroup(nodeName, groupName);
   if (ret) {
+    ScopedLock lock(nodeItemMapMtx_);
     BodyTreeItemMap_t::iterator _nodes = nodeItemMap_.find(nodeName);
     BodyTreeItemMap_t::iterator _groups = nodeItemMap_.find(groupName);
     assert(_nodes != nodeItemMap_.end());
@@ -152,7 +160,7 @@ bool WindowsManager::removeFromGroup(const std::string& nodeName,
       BodyTreeItems_t::const_iterator _group = std::find(
           groups.begin(), groups.end(), (*_node)->QStandardItem::parent());
       if (_group == groups.end()) continue;
-      bodyTree_->model()->takeRow((*_node)->row());
+      takeItem(*_node);
       nodes.erase(_node);
       found = true;
       break;
@@ -164,33 +172,153 @@ bool WindowsManager::removeFromGroup(const std::string& nodeName,
   return ret;
 }
 
-bool WindowsManager::deleteNode(const std::string& nodeName, bool all) {
-  bool ret = Parent_t::deleteNode(nodeName, all);
-  if (ret) deleteBodyItem(nodeName);
-  return ret;
-}
-
-BodyTreeItems_t WindowsManager::bodyTreeItems(const std::string& name) const {
+BodyTreeItems_t WindowsManager::bodyTreeItems(const std::string& name) {
+  // The items must be in the model to be selected.
+  if (QThread::currentThread() == bodyTree_->thread()) appendPendingItems();
+  ScopedLock lock(nodeItemMapMtx_);
   BodyTreeItemMap_t::const_iterator _btis = nodeItemMap_.find(name);
   if (_btis != nodeItemMap_.end()) return _btis->second.first;
   return BodyTreeItems_t();
 }
 
-void WindowsManager::deleteBodyItem(const std::string& nodeName) {
-  BodyTreeItemMap_t::iterator _nodes = nodeItemMap_.find(nodeName);
-  assert(_nodes != nodeItemMap_.end());
-  for (std::size_t i = 0; i < _nodes->second.first.size(); ++i) {
-    BodyTreeItem* bti = _nodes->second.first[i];
-    QStandardItem* parent = bti->QStandardItem::parent();
+void WindowsManager::nodesDeleted(const std::vector<std::string>& nodeNames) {
+  ScopedLock mapLock(nodeItemMapMtx_);
+  ScopedLock lock(pendingItemsMtx_);
+  const bool scheduled = !deletedItems_.empty();
+  for (std::size_t i = 0; i < nodeNames.size(); ++i) {
+    BodyTreeItemMap_t::iterator _nodes = nodeItemMap_.find(nodeNames[i]);
+    if (_nodes == nodeItemMap_.end()) continue;
+    deletedItems_.insert(deletedItems_.end(), _nodes->second.first.begin(),
+                         _nodes->second.first.end());
+    nodeItemMap_.erase(_nodes);
+  }
+  if (!scheduled && !deletedItems_.empty())
+    QMetaObject::invokeMethod(this, "deletePendingItems",
+                              Qt::QueuedConnection);
+}
+
+void WindowsManager::deletePendingItems() {
+  // The deleted items may have children waiting to be appended.
+  appendPendingItems();
+  // The model is modified without the lock, so that the nodes can be
+  // deleted meanwhile.
+  std::vector<BodyTreeItem*> deletedItems;
+  {
+    ScopedLock lock(pendingItemsMtx_);
+    deletedItems.swap(deletedItems_);
+  }
+  if (deletedItems.empty()) return;
+  const std::set<QStandardItem*> deleted(deletedItems.begin(),
+                                         deletedItems.end());
+
+  // Only the items without deleted ancestor are removed from their parent.
+  // The others are deleted with them.
+  typedef std::pair<QStandardItem*, int> Row_t;
+  std::vector<Row_t> rows;
+  for (std::size_t i = 0; i < deletedItems.size(); ++i) {
+    BodyTreeItem* item = deletedItems[i];
+    QStandardItem* parent = item->QStandardItem::parent();
+    bool root = true;
+    for (QStandardItem* p = parent; root && p != NULL; p = p->parent())
+      root = (deleted.count(p) == 0);
+    if (!root) continue;
     if (parent == NULL) {
-      bodyTree_->model()->takeRow(bti->row());
-    } else {
-      parent->takeRow(bti->row());
+      if (item->model() == NULL) {
+        delete item;
+        continue;
+      }
+      parent = bodyTree_->model()->invisibleRootItem();
     }
-    bti->deleteLater();
-    _nodes->second.first[i] = NULL;
+    rows.push_back(Row_t(parent, item->row()));
+  }
+
+  // Remove the rows from the last one, by ranges of consecutive rows.
+  std::sort(rows.rbegin(), rows.rend());
+  QTreeView* view = bodyTree_->view();
+  bool updatesEnabled = view->updatesEnabled();
+  view->setUpdatesEnabled(false);
+  for (std::size_t i = 0; i < rows.size();) {
+    std::size_t j = i + 1;
+    while (j < rows.size() && rows[j].first == rows[i].first &&
+           rows[j].second == rows[j - 1].second - 1)
+      ++j;
+    rows[i].first->removeRows(rows[j - 1].second, (int)(j - i));
+    i = j;
+  }
+  view->setUpdatesEnabled(updatesEnabled);
+}
+
+void WindowsManager::appendItem(QStandardItem* parent, BodyTreeItem* item) {
+  ScopedLock lock(pendingItemsMtx_);
+  // The parent is not in the model yet, nor being inserted into it.
+  if (parent != NULL && parent->model() == NULL && !appendingItems_) {
+    parent->appendRow(item);
+    return;
+  }
+  pendingItems_.push_back(std::make_pair(parent, item));
+  if (pendingItems_.size() == 1 && takenItems_.empty())
+    QMetaObject::invokeMethod(this, "appendPendingItems",
+                              Qt::QueuedConnection);
+}
+
+void WindowsManager::appendPendingItems() {
+  // The model is modified without the lock, so that the nodes can be
+  // created meanwhile.
+  PendingItems_t pendingItems;
+  std::vector<BodyTreeItem*> takenItems;
+  {
+    ScopedLock lock(pendingItemsMtx_);
+    if (pendingItems_.empty() && takenItems_.empty()) return;
+    pendingItems.swap(pendingItems_);
+    takenItems.swap(takenItems_);
+    appendingItems_ = true;
+  }
+  QTreeView* view = bodyTree_->view();
+  bool updatesEnabled = view->updatesEnabled();
+  view->setUpdatesEnabled(false);
+  for (std::size_t i = 0; i < pendingItems.size();) {
+    QStandardItem* parent = pendingItems[i].first;
+    QList<QStandardItem*> items;
+    for (; i < pendingItems.size() && pendingItems[i].first == parent; ++i)
+      items.append(pendingItems[i].second);
+    if (parent == NULL) parent = bodyTree_->model()->invisibleRootItem();
+    parent->appendRows(items);
+  }
+  for (std::size_t i = 0; i < takenItems.size(); ++i) {
+    BodyTreeItem* item = takenItems[i];
+    QStandardItem* parent = item->QStandardItem::parent();
+    if (parent != NULL)
+      parent->takeRow(item->row());
+    else if (item->model() != NULL)
+      bodyTree_->model()->takeRow(item->row());
+  }
+  view->setUpdatesEnabled(updatesEnabled);
+  ScopedLock lock(pendingItemsMtx_);
+  appendingItems_ = false;
+}
+
+void WindowsManager::takeItem(BodyTreeItem* item) {
+  ScopedLock lock(pendingItemsMtx_);
+  PendingItems_t::iterator pending = pendingItems_.begin();
+  while (pending != pendingItems_.end() && pending->second != item) ++pending;
+  if (pending == pendingItems_.end()) {
+    // The item is in the model, or being inserted into it. It is taken
+    // after the pending items, by appendPendingItems.
+    takenItems_.push_back(item);
+    if (takenItems_.size() == 1 && pendingItems_.empty())
+      QMetaObject::invokeMethod(this, "appendPendingItems",
+                                Qt::QueuedConnection);
+    return;
+  }
+  pendingItems_.erase(pending);
+  // The children follow their parent, which is not in the model.
+  for (std::size_t i = 0; i < pendingItems_.size();) {
+    if (pendingItems_[i].first == item) {
+      item->appendRow(pendingItems_[i].second);
+      pendingItems_.erase(pendingItems_.begin() + (std::ptrdiff_t)i);
+    } else
+      ++i;
   }
-  nodeItemMap_.erase(_nodes);
 }
 
 bool WindowsManager::initParent(NodePtr_t node, GroupNodePtr_t parent,
@@ -8,7 +8,6 @@
 
 #include <gepetto/viewer/leaf-node-arrow.h>
 
-#include <osg/Version>
 
 namespace gepetto {
 namespace viewer {
@@ -16,18 +15,11 @@ namespace viewer {
 /* Declaration of private function members */
 
 void LeafNodeArrow::init() {
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new osg::Geode();
+  /* Create cylinder and cone objects */
+  cylinder_ptr_ = addUnitShape(UNIT_CYLINDER);
+  cone_ptr_ = addUnitShape(UNIT_CONE);
 
-  resetGeodeContent();
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
-  ;
+  updateShapeTransform();
 
   addProperty(FloatProperty::create(
       "Radius",
@@ -40,50 +32,49 @@ void LeafNodeArrow::init() {
       FloatProperty::setterFromMemberFunction(this, &LeafNodeArrow::setSize)));
 }
 
-void LeafNodeArrow::resetGeodeContent() {
-  if (cylinder_drawable_) geode_ptr_->removeDrawable(cylinder_drawable_);
-  if (cone_drawable_) geode_ptr_->removeDrawable(cone_drawable_);
-
+void LeafNodeArrow::updateShapeTransform() {
   /* create the axis : */
   float R = getRadius();
   float L = getSize();
   float Lcone = std::min(L, 4.f * R);
 
-  /* Create cylinder */
-  ::osg::CylinderRefPtr cylinder_shape_x_ptr = new ::osg::Cylinder();
-  cylinder_shape_x_ptr->set(osgVector3((L - Lcone) / 2.f, 0.f, 0.f), R,
-                            L - Lcone);
-  cylinder_shape_x_ptr->setRotation(
-      osgQuat(0.f, ::osg::X_AXIS, M_PI_2, ::osg::Y_AXIS, 0.f, ::osg::Z_AXIS));
-  /* Create cone */
-  ::osg::ConeRefPtr cone_shape_x_ptr = new ::osg::Cone();
-  cone_shape_x_ptr->set(osgVector3(L - 3 * Lcone / 4, 0.f, 0.f), 2.f * R,
-                        Lcone);
-  cone_shape_x_ptr->setRotation(
-      osgQuat(0.f, ::osg::X_AXIS, M_PI_2, ::osg::Y_AXIS, 0.f, ::osg::Z_AXIS));
-
-  /* create drawable and add them to geode */
-  cylinder_drawable_ = new ::osg::ShapeDrawable(cylinder_shape_x_ptr);
-  cone_drawable_ = new ::osg::ShapeDrawable(cone_shape_x_ptr);
-  setColor(color_);
-
-  geode_ptr_->addDrawable(cylinder_drawable_);
-  geode_ptr_->addDrawable(cone_drawable_);
+  // The unit shapes are along Z and the arrow is along X.
+  const ::osg::Matrix toX(::osg::Matrix::rotate(
+      osgQuat(0.f, ::osg::X_AXIS, M_PI_2, ::osg::Y_AXIS, 0.f, ::osg::Z_AXIS)));
+
+  /* Update cylinder */
+  // A null scale cannot be inverted, which picking requires.
+  cylinder_ptr_->setNodeMask(L > Lcone ? ~0x0 : 0x0);
+  if (L > Lcone)
+    cylinder_ptr_->setMatrix(
+        ::osg::Matrix::scale(R, R, L - Lcone) * toX *
+        ::osg::Matrix::translate((L - Lcone) / 2.f, 0.f, 0.f));
+  /* Update cone */
+  cone_ptr_->setNodeMask(Lcone > 0 ? ~0x0 : 0x0);
+  if (Lcone > 0)
+    cone_ptr_->setMatrix(
+        ::osg::Matrix::scale(2.f * R, 2.f * R, Lcone) * toX *
+        ::osg::Matrix::translate(L - 3 * Lcone / 4, 0.f, 0.f));
+  setDirty();
 }
 
 LeafNodeArrow::LeafNodeArrow(const std::string& name, const osgVector4& color,
                              float radius, float size)
-    : NodeDrawable(name), color_(color) {
+    : NodeDrawable(name) {
   radius_ = radius;
   size_ = size;
 
   init();
+  setColor(color);
 }
 
 LeafNodeArrow::LeafNodeArrow(const LeafNodeArrow& other)
     : NodeDrawable(other.getID()) {
+  radius_ = other.getRadius();
+  size_ = other.getSize();
+
   init();
-  // TODO
+  setColor(other.getColor());
 }
 
 void LeafNodeArrow::initWeakPtr(LeafNodeArrowWeakPtr other_weak_ptr) {
@@ -140,7 +131,7 @@ LeafNodeArrowPtr_t LeafNodeArrow::self(void) const { return weak_ptr_.lock(); }
 void LeafNodeArrow::setRadius(const float& radius) {
   if (radius != getRadius()) {  // avoid useless resize
     radius_ = radius;
-    resetGeodeContent();
+    updateShapeTransform();
   }
 }
 
@@ -149,49 +140,22 @@ float LeafNodeArrow::getRadius() const { return radius_; }
 void LeafNodeArrow::setSize(const float& size) {
   if (size != getSize()) {  // avoid useless resize
     size_ = size;
-    resetGeodeContent();
+    updateShapeTransform();
   }
 }
 
 float LeafNodeArrow::getSize() const { return size_; }
 
-void LeafNodeArrow::setColor(const osgVector4& color) {
-  cylinder_drawable_->setColor(color);
-  cone_drawable_->setColor(color);
-#if OSG_VERSION_GREATER_OR_EQUAL(3, 5, 6)
-  cylinder_drawable_->build();
-  cone_drawable_->build();
-#else
-  cylinder_drawable_->dirtyDisplayList();
-  cone_drawable_->dirtyDisplayList();
-  cylinder_drawable_->dirtyBound();
-  cone_drawable_->dirtyBound();
-#endif
-  color_ = color;
-  setTransparentRenderingBin(color[3] <
-                             Node::TransparencyRenderingBinThreshold);
-  setDirty();
-}
-
 void LeafNodeArrow::resize(float radius, float length) {
   if (length != getSize() || radius != getRadius()) {  // avoid useless resize
     size_ = length;
     radius_ = radius;
 
-    resetGeodeContent();
+    updateShapeTransform();
   }
 }
 
 LeafNodeArrow::~LeafNodeArrow() {
-  /* Proper deletion of all tree scene */
-
-  geode_ptr_->removeDrawable(cylinder_drawable_);
-  geode_ptr_->removeDrawable(cone_drawable_);
-
-  geode_ptr_ = NULL;
-  cylinder_drawable_ = NULL;
-  cone_drawable_ = NULL;
-
   weak_ptr_.reset();
 }
 
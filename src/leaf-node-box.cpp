@@ -14,29 +14,15 @@ namespace viewer {
 /* Declaration of private function members */
 
 void LeafNodeBox::init() {
-  /* Create sphere object */
-  box_ptr_ = new ::osg::Box();
-
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new ::osg::ShapeDrawable(box_ptr_);
-
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new ::osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
+  /* Create box object */
+  shape_transform_ptr_ = addUnitShape(UNIT_BOX);
 
   addProperty(
       Vector3Property::create("HalfLength",
                               Vector3Property::getterFromMemberFunction(
-                                  box_ptr_.get(), &osg::Box::getHalfLengths),
+                                  this, &LeafNodeBox::getHalfAxis),
                               Vector3Property::setterFromMemberFunction(
                                   this, &LeafNodeBox::setHalfAxis)));
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
 }
 
 LeafNodeBox::LeafNodeBox(const std::string& name, const osgVector3& half_axis)
@@ -54,7 +40,8 @@ LeafNodeBox::LeafNodeBox(const std::string& name, const osgVector3& half_axis,
   setColor(color);
 }
 
-LeafNodeBox::LeafNodeBox(const LeafNodeBox& other) : NodeDrawable(other) {
+LeafNodeBox::LeafNodeBox(const LeafNodeBox& other)
+    : NodeDrawable(other.getID()) {
   init();
   setHalfAxis(other.getHalfAxis());
   setColor(other.getColor());
@@ -109,18 +96,12 @@ LeafNodeBoxPtr_t LeafNodeBox::clone(void) const {
 LeafNodeBoxPtr_t LeafNodeBox::self(void) const { return weak_ptr_.lock(); }
 
 void LeafNodeBox::setHalfAxis(const osgVector3& half_axis) {
-  box_ptr_->setHalfLengths(half_axis);
-  redrawShape();
+  half_axis_ = half_axis;
+  shape_transform_ptr_->setMatrix(::osg::Matrix::scale(half_axis));
+  setDirty();
 }
 
 LeafNodeBox::~LeafNodeBox() {
-  /* Proper deletion of all tree scene */
-  geode_ptr_->removeDrawable(shape_drawable_ptr_);
-  shape_drawable_ptr_ = NULL;
-
-  this->asQueue()->removeChild(geode_ptr_);
-  geode_ptr_ = NULL;
-
   weak_ptr_.reset();
 }
 
@@ -15,15 +15,10 @@ namespace viewer {
 
 void LeafNodeCapsule::init() {
   /* Create capsule object */
-
-  capsule_ptr_ = new ::osg::Capsule();
-
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new ::osg::ShapeDrawable(capsule_ptr_);
-
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
+  radius_ = height_ = 1.f;
+  body_ptr_ = addUnitShape(UNIT_CAPSULE_BODY);
+  top_ptr_ = addUnitShape(UNIT_CAPSULE_TOP);
+  bottom_ptr_ = addUnitShape(UNIT_CAPSULE_BOTTOM);
 
   RangedFloatProperty::Ptr_t radiusProp = RangedFloatProperty::create(
       "Radius", this, &LeafNodeCapsule::getRadius, &LeafNodeCapsule::setRadius);
@@ -38,13 +33,6 @@ void LeafNodeCapsule::init() {
   heightProp->step = 0.1f;
   heightProp->adaptiveDecimal = true;
   addProperty(heightProp);
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
 }
 
 LeafNodeCapsule::LeafNodeCapsule(const std::string& name, const float& radius,
@@ -66,7 +54,7 @@ LeafNodeCapsule::LeafNodeCapsule(const std::string& name, const float& radius,
 }
 
 LeafNodeCapsule::LeafNodeCapsule(const LeafNodeCapsule& other)
-    : NodeDrawable(other) {
+    : NodeDrawable(other.getID()) {
   init();
   setRadius(other.getRadius());
   setHeight(other.getHeight());
@@ -128,24 +116,27 @@ LeafNodeCapsulePtr_t LeafNodeCapsule::self(void) const {
 }
 
 void LeafNodeCapsule::setRadius(const float& radius) {
-  capsule_ptr_->setRadius(radius);
-  redrawShape();
-  setDirty();
+  radius_ = radius;
+  updateShapeTransform();
 }
 
 void LeafNodeCapsule::setHeight(const float& height) {
-  capsule_ptr_->setHeight(height);
-  redrawShape();
+  height_ = height;
+  updateShapeTransform();
 }
 
-LeafNodeCapsule::~LeafNodeCapsule() {
-  /* Proper deletion of all tree scene */
-  geode_ptr_->removeDrawable(shape_drawable_ptr_);
-  shape_drawable_ptr_ = NULL;
-
-  this->asQueue()->removeChild(geode_ptr_);
-  geode_ptr_ = NULL;
+void LeafNodeCapsule::updateShapeTransform() {
+  const ::osg::Matrix capScale(
+      ::osg::Matrix::scale(radius_, radius_, radius_));
+  body_ptr_->setMatrix(::osg::Matrix::scale(radius_, radius_, height_));
+  top_ptr_->setMatrix(capScale *
+                      ::osg::Matrix::translate(0.f, 0.f, height_ / 2.f));
+  bottom_ptr_->setMatrix(capScale *
+                         ::osg::Matrix::translate(0.f, 0.f, -height_ / 2.f));
+  setDirty();
+}
 
+LeafNodeCapsule::~LeafNodeCapsule() {
   weak_ptr_.reset();
 }
 
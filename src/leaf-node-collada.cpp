@@ -7,17 +7,25 @@
 //
 
 #include <gepetto/viewer/leaf-node-collada.h>
+#include <gepetto/viewer/texture-cache.h>
 #include <sys/stat.h>
 
 #include <clocale>
 #include <fstream>
 #include <ios>
+#include <limits>
+#include <osg/Geometry>
+#include <osg/KdTree>
 #include <osg/LightModel>
 #include <osg/Texture2D>
+#include <osg/ValueObject>
 #include <osg/Version>
 #include <osgDB/FileNameUtils>
+#include <osgDB/WriteFile>
 #include <osgUtil/Optimizer>
+#include <osgUtil/Simplifier>
 
+#include "cache-file.hh"
 #include "log.hh"
 
 namespace gepetto {
@@ -47,6 +55,136 @@ class LightSourceRemoving : public osg::NodeVisitor {
   }
 };
 
+/// Prepare the geometries for static rendering from vertex buffer objects.
+class StaticGeometrySetup : public osg::NodeVisitor {
+ public:
+  StaticGeometrySetup() : NodeVisitor(TRAVERSE_ALL_CHILDREN) {}
+
+  void apply(osg::Geode& geode) {
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i) {
+      osg::Geometry* geom = geode.getDrawable(i)->asGeometry();
+      if (geom == NULL) continue;
+      // Tangents and other generic attributes are not used by the fixed
+      // function pipeline.
+      geom->getVertexAttribArrayList().clear();
+      geom->setDataVariance(osg::Object::STATIC);
+      geom->setUseDisplayList(false);
+      geom->setUseVertexBufferObjects(true);
+    }
+    traverse(geode);
+  }
+};
+
+/// Build the KD-trees which make the intersection of the triangles of a mesh,
+/// for picking, logarithmic in the number of triangles.
+class KdTreeSetup : public osg::NodeVisitor {
+ public:
+  KdTreeSetup() : NodeVisitor(TRAVERSE_ALL_CHILDREN) {}
+
+  void apply(osg::Geode& geode) {
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i) {
+      osg::Geometry* geom = geode.getDrawable(i)->asGeometry();
+      if (geom == NULL) continue;
+      // Copies of a geometry share its KD-tree, which does not match the
+      // copy once it is modified.
+      geom->setShape(NULL);
+      osg::ref_ptr<osg::KdTree> kdTree = new osg::KdTree;
+      if (kdTree->build(options_, geom)) geom->setShape(kdTree);
+    }
+    traverse(geode);
+  }
+
+ private:
+  osg::KdTree::BuildOptions options_;
+};
+
+/// Optimize a mesh once. Meshes returned by the object cache are already
+/// optimized.
+void optimizeMesh(osg::Node* mesh) {
+  static const std::string optimizedKey("gv_optimized");
+  bool optimized = false;
+  if (mesh->getUserValue(optimizedKey, optimized) && optimized) return;
+
+  osgUtil::Optimizer optimizer;
+  optimizer.optimize(mesh, osgUtil::Optimizer::DEFAULT_OPTIMIZATIONS |
+                               osgUtil::Optimizer::INDEX_MESH |
+                               osgUtil::Optimizer::VERTEX_POSTTRANSFORM |
+                               osgUtil::Optimizer::VERTEX_PRETRANSFORM);
+  StaticGeometrySetup setup;
+  mesh->accept(setup);
+  KdTreeSetup kdTrees;
+  mesh->accept(kdTrees);
+  mesh->setUserValue(optimizedKey, true);
+}
+
+/// Sample ratio of the simplified meshes and size on screen, in pixels,
+/// below which they are used. Sizes on screen, unlike distances relative to
+/// the mesh radius, also select the full mesh for a large environment seen
+/// from inside.
+const std::size_t nLevelsOfDetail = 2;
+const float lodSampleRatios[nLevelsOfDetail] = {0.25f, 0.05f};
+const float lodPixelSizes[nLevelsOfDetail] = {200.f, 50.f};
+const char* lodLevelsName = "gv_lod_levels";
+
+/// Name of the mesh file of a loaded mesh, whose levels of detail are cached
+/// on disk.
+const char* meshFileKey = "gv_mesh_file";
+
+/// Get the simplified meshes, which are stored in the user data of the mesh
+/// so that they are shared by all the nodes using this mesh. The levels of a
+/// loaded mesh are also cached on disk, in the cache directory of the user.
+osg::Group* getOrCreateLODLevels(osg::Node* mesh, osgDB::Options* options) {
+  osg::UserDataContainer* udc = mesh->getUserDataContainer();
+  if (udc) {
+    unsigned int i = udc->getUserObjectIndex(lodLevelsName);
+    if (i < udc->getNumUserObjects())
+      return static_cast<osg::Group*>(udc->getUserObject(i));
+  }
+
+  std::string meshFile, cacheFile;
+  if (mesh->getUserValue(meshFileKey, meshFile))
+    cacheFile = cacheFileName(meshFile, ".lod.osgb");
+
+  osg::ref_ptr<osg::Group> levels;
+  if (!cacheFile.empty() && fileExists(cacheFile.c_str())) {
+    osg::ref_ptr<osg::Node> cached = osgDB::readNodeFile(cacheFile, options);
+    levels = dynamic_cast<osg::Group*>(cached.get());
+    if (levels && levels->getNumChildren() != nLevelsOfDetail) levels = NULL;
+    if (levels) log() << "Using " << cacheFile << std::endl;
+  }
+  if (!levels) {
+    levels = new osg::Group;
+    levels->setName(lodLevelsName);
+    for (std::size_t k = 0; k < nLevelsOfDetail; ++k) {
+      // State sets are shared so that textures and materials of the mesh
+      // apply to all the levels.
+      osg::ref_ptr<osg::Node> simplified =
+          osg::clone(mesh, osg::CopyOp::DEEP_COPY_NODES |
+                               osg::CopyOp::DEEP_COPY_DRAWABLES |
+                               osg::CopyOp::DEEP_COPY_ARRAYS |
+                               osg::CopyOp::DEEP_COPY_PRIMITIVES);
+      // The user data container is shared by the copy. Removing it avoids a
+      // reference cycle.
+      simplified->setUserDataContainer(NULL);
+      osgUtil::Simplifier simplifier(lodSampleRatios[k]);
+      simplified->accept(simplifier);
+      levels->addChild(simplified);
+    }
+    // The KD-trees are not written, they are rebuilt when reading the cache.
+    if (!cacheFile.empty() && !osgDB::writeNodeFile(*levels, cacheFile))
+      logCacheWriteFailure(cacheFile);
+  }
+  // The levels read from disk may be shared through the object cache.
+  bool indexed = false;
+  if (!levels->getUserValue("gv_kd_trees", indexed)) {
+    KdTreeSetup kdTrees;
+    levels->accept(kdTrees);
+    levels->setUserValue("gv_kd_trees", true);
+  }
+  mesh->getOrCreateUserDataContainer()->addUserObject(levels);
+  return levels.get();
+}
+
 #if OSG_VERSION_LESS_THAN(3, 3, 3)
 struct ObjectCache {
   typedef std::map<std::string, osg::NodeRefPtr> Map_t;
@@ -92,6 +230,9 @@ void LeafNodeCollada::init() {
       throw std::invalid_argument(std::string("File ") + collada_file_path_ +
                                   std::string(" not found."));
 
+    // The scale of a DAE file is applied to the loaded mesh, which may be
+    // shared with other nodes through the object cache.
+    float scale = 1.f;
     std::string osgname = getCachedFileName(collada_file_path_);
     if (!osgname.empty()) {
       log() << "Using " << osgname << std::endl;
@@ -103,7 +244,6 @@ void LeafNodeCollada::init() {
         options_->setOptionString("noRotation");
         collada_ptr_ = osgDB::readNodeFile(collada_file_path_, options_);
       } else if (ext == "dae") {
-        float scale = 1.f;
         options_->setPluginData("DAE-AssetUnitMeter", &scale);
         if (*localeconv()->decimal_point != '.') {
           std::cerr
@@ -117,6 +257,13 @@ void LeafNodeCollada::init() {
         }
 
         collada_ptr_ = osgDB::readNodeFile(collada_file_path_, options_);
+        options_->removePluginData("DAE-AssetUnitMeter");
+        // The plugin does not set the scale of a mesh found in the object
+        // cache, hence the scale is stored in the mesh.
+        if (collada_ptr_ && scale != 1.f)
+          collada_ptr_->setUserValue("gv_unit_scale", scale);
+        else if (collada_ptr_)
+          collada_ptr_->getUserValue("gv_unit_scale", scale);
 
         // FIXME: Fixes https://github.com/Gepetto/gepetto-viewer/issues/95
         // The bug: Assimp seems to ignore the DAE up_axis tag. Because this
@@ -150,14 +297,6 @@ void LeafNodeCollada::init() {
               << collada_file_path_ << ' ' << collada_file_path_ << ".osgb"
               << std::endl;
         }
-        // Apply scale
-        if (scale != 1.) {
-          osg::ref_ptr<osg::MatrixTransform> xform = new osg::MatrixTransform;
-          xform->setDataVariance(osg::Object::STATIC);
-          xform->setMatrix(osg::Matrix::scale(scale, scale, scale));
-          xform->addChild(collada_ptr_);
-          collada_ptr_ = xform;
-        }
       } else
         collada_ptr_ = osgDB::readNodeFile(collada_file_path_, options_);
     }
@@ -166,19 +305,39 @@ void LeafNodeCollada::init() {
           std::string("File ") + collada_file_path_ +
           std::string(
               " found but could not be opened. Check that a plugin exist."));
+
+    // The loaded mesh is optimized, rather than the scale transform, so that
+    // the optimization is done once and does not flatten the scale into the
+    // shared geometries.
+    optimizeMesh(collada_ptr_);
+    mesh_ptr_ = collada_ptr_;
+    unit_scale_ = scale;
+
+    // Apply scale
+    if (scale != 1.) {
+      osg::ref_ptr<osg::MatrixTransform> xform = new osg::MatrixTransform;
+      xform->setDataVariance(osg::Object::STATIC);
+      xform->setMatrix(osg::Matrix::scale(scale, scale, scale));
+      xform->addChild(collada_ptr_);
+      collada_ptr_ = xform;
+    }
 #if OSG_VERSION_LESS_THAN(3, 3, 3)
+    // This cache shares the scaled mesh.
     object_cache.add(collada_file_path_, collada_ptr_);
+    mesh_ptr_ = collada_ptr_;
+    unit_scale_ = 1.f;
 #endif
 
     /* Allow transparency */
     collada_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
                                                  ::osg::StateAttribute::ON);
     collada_ptr_->setDataVariance(osg::Object::STATIC);
-
-    osgUtil::Optimizer optimizer;
-    optimizer.optimize(collada_ptr_, osgUtil::Optimizer::DEFAULT_OPTIMIZATIONS);
+    // The levels of detail of the loaded mesh can be cached on disk. Those
+    // of a mesh modified by applyScale cannot.
+    mesh_ptr_->setUserValue(meshFileKey, collada_file_path_);
   }
 
+  if (!mesh_ptr_) mesh_ptr_ = collada_ptr_;
   collada_ptr_->setName("meshfile");
   backfaceDrawing_.stateSet(collada_ptr_->getOrCreateStateSet());
   backfaceDrawing_.set(false);
@@ -208,18 +367,30 @@ void LeafNodeCollada::init() {
   addProperty(VoidProperty::create(
       "ApplyScale",
       VoidProperty::memberFunction(this, &LeafNodeCollada::applyScale)));
+  addProperty(BoolProperty::create("LevelOfDetail", this,
+                                   &LeafNodeCollada::getLevelOfDetail,
+                                   &LeafNodeCollada::setLevelOfDetail));
+  addProperty(BoolProperty::create("OcclusionQuery", this,
+                                   &LeafNodeCollada::getOcclusionQuery,
+                                   &LeafNodeCollada::setOcclusionQuery));
 }
 
 LeafNodeCollada::LeafNodeCollada(const std::string& name,
                                  const std::string& collada_file_path)
-    : Node(name), collada_file_path_(collada_file_path), collada_ptr_() {
+    : Node(name),
+      collada_file_path_(collada_file_path),
+      collada_ptr_(),
+      unit_scale_(1.f) {
   init();
 }
 
 LeafNodeCollada::LeafNodeCollada(const std::string& name,
                                  const std::string& collada_file_path,
                                  const osgVector4& color)
-    : Node(name), collada_file_path_(collada_file_path), collada_ptr_() {
+    : Node(name),
+      collada_file_path_(collada_file_path),
+      collada_ptr_(),
+      unit_scale_(1.f) {
   init();
   setColor(color);
 }
@@ -227,12 +398,17 @@ LeafNodeCollada::LeafNodeCollada(const std::string& name,
 LeafNodeCollada::LeafNodeCollada(const std::string& name,
                                  const ::osg::NodeRefPtr& node,
                                  const std::string& collada_file_path)
-    : Node(name), collada_file_path_(collada_file_path), collada_ptr_(node) {
+    : Node(name),
+      collada_file_path_(collada_file_path),
+      collada_ptr_(node),
+      unit_scale_(1.f) {
   init();
 }
 
 LeafNodeCollada::LeafNodeCollada(const LeafNodeCollada& other)
-    : Node(other.getID()), collada_file_path_(other.collada_file_path_) {
+    : Node(other.getID()),
+      collada_file_path_(other.collada_file_path_),
+      unit_scale_(1.f) {
   init();
 }
 
@@ -240,6 +416,15 @@ void LeafNodeCollada::initWeakPtr(LeafNodeColladaWeakPtr other_weak_ptr) {
   weak_ptr_ = other_weak_ptr;
 }
 
+void LeafNodeCollada::setDrawnByInstancer(bool instanced) {
+  osg::Node::NodeMask mask = group_ptr_->getNodeMask();
+  if (instanced)
+    mask &= ~VisibilityBit;
+  else
+    mask |= VisibilityBit;
+  group_ptr_->setNodeMask(mask);
+}
+
 /* End of declaration of private function members */
 
 /* Declaration of protected function members */
@@ -357,14 +542,11 @@ void LeafNodeCollada::setAlpha(const float& alpha) {
 
 void LeafNodeCollada::setTexture(const std::string& image_path) {
   texture_file_path_ = image_path;
-  osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-  texture->setDataVariance(osg::Object::STATIC);
-  osg::ref_ptr<osg::Image> image = osgDB::readImageFile(image_path);
-  if (!image) {
+  osg::ref_ptr<osg::Texture2D> texture = TextureCache::get(image_path);
+  if (!texture) {
     log() << " couldn't find texture, quiting." << std::endl;
     return;
   }
-  texture->setImage(image);
   collada_ptr_->getOrCreateStateSet()->setTextureAttributeAndModes(
       0, texture, osg::StateAttribute::ON);
   setDirty();
@@ -415,6 +597,9 @@ void LeafNodeCollada::removeLightSources() {
 void LeafNodeCollada::applyScale() {
   osgVector3 scale(getScale());
   setScale(1.);
+  // The simplified meshes are recomputed for the scaled mesh.
+  bool lod = getLevelOfDetail();
+  setLevelOfDetail(false);
 
   // Do not remove this brackets. See
   // https://github.com/openscenegraph/OpenSceneGraph/issues/1020
@@ -431,8 +616,61 @@ void LeafNodeCollada::applyScale() {
   osgUtil::Optimizer optimizer;
   optimizer.optimize(collada_ptr_,
                      osgUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS);
+  // The vertices moved.
+  KdTreeSetup kdTrees;
+  collada_ptr_->accept(kdTrees);
+  mesh_ptr_ = collada_ptr_;
+  unit_scale_ = 1.f;
 
   group_ptr_->addChild(collada_ptr_);
+  setLevelOfDetail(lod);
+}
+
+void LeafNodeCollada::setLevelOfDetail(bool enable) {
+  if (enable == getLevelOfDetail()) return;
+  if (enable) {
+    // The levels are shared by the nodes loading the same file, below their
+    // unit scale.
+    osg::Group* levels = getOrCreateLODLevels(mesh_ptr_, options_.get());
+
+    lod_ptr_ = new osg::LOD;
+    lod_ptr_->setName("levelOfDetail");
+    lod_ptr_->setRangeMode(osg::LOD::PIXEL_SIZE_ON_SCREEN);
+    lod_ptr_->addChild(collada_ptr_, lodPixelSizes[0],
+                       std::numeric_limits<float>::max());
+    for (std::size_t k = 0; k < nLevelsOfDetail; ++k) {
+      osg::ref_ptr<osg::Node> level = levels->getChild((unsigned int)k);
+      if (collada_ptr_ != mesh_ptr_) {
+        // Apply the unit scale, and its state, to the level.
+        osg::ref_ptr<osg::Group> scaled = static_cast<osg::Group*>(
+            collada_ptr_->clone(osg::CopyOp::SHALLOW_COPY));
+        scaled->removeChildren(0, scaled->getNumChildren());
+        scaled->addChild(level);
+        level = scaled;
+      }
+      float min = (k + 1 < nLevelsOfDetail ? lodPixelSizes[k + 1] : 0.f);
+      lod_ptr_->addChild(level, min, lodPixelSizes[k]);
+    }
+    group_ptr_->replaceChild(collada_ptr_, lod_ptr_);
+  } else {
+    group_ptr_->replaceChild(lod_ptr_, collada_ptr_);
+    lod_ptr_ = NULL;
+  }
+  setDirty();
+}
+
+void LeafNodeCollada::setOcclusionQuery(bool enable) {
+  if (enable == getOcclusionQuery()) return;
+  if (enable) {
+    occlusion_query_ptr_ = new osg::OcclusionQueryNode;
+    occlusion_query_ptr_->setName("occlusionQuery");
+    occlusion_query_ptr_->addChild(group_ptr_);
+    asQueue()->replaceChild(group_ptr_, occlusion_query_ptr_);
+  } else {
+    asQueue()->replaceChild(occlusion_query_ptr_, group_ptr_);
+    occlusion_query_ptr_ = NULL;
+  }
+  setDirty();
 }
 
 void LeafNodeCollada::removeFromCache() {
@@ -446,8 +684,11 @@ void LeafNodeCollada::removeFromCache() {
 LeafNodeCollada::~LeafNodeCollada() {
   /* Proper deletion of all tree scene */
   group_ptr_->removeChild(collada_ptr_);
+  group_ptr_->removeChild(lod_ptr_);
+  lod_ptr_ = NULL;
 
   collada_ptr_ = NULL;
+  mesh_ptr_ = NULL;
 
   weak_ptr_.reset();
 }
@@ -15,21 +15,8 @@ namespace viewer {
 
 void LeafNodeCone::init() {
   /* Create cone object */
-  cone_ptr_ = new osg::Cone();
-
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new osg::ShapeDrawable(cone_ptr_);
-
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
+  radius_ = height_ = 1.f;
+  shape_transform_ptr_ = addUnitShape(UNIT_CONE);
 }
 
 LeafNodeCone::LeafNodeCone(const std::string& name, const float& radius,
@@ -49,7 +36,8 @@ LeafNodeCone::LeafNodeCone(const std::string& name, const float& radius,
   setHeight(height);
   setColor(color);
 }
-LeafNodeCone::LeafNodeCone(const LeafNodeCone& other) : NodeDrawable(other) {
+LeafNodeCone::LeafNodeCone(const LeafNodeCone& other)
+    : NodeDrawable(other.getID()) {
   init();
   setRadius(other.getRadius());
   setHeight(other.getHeight());
@@ -106,23 +94,22 @@ LeafNodeConePtr_t LeafNodeCone::clone(void) const {
 LeafNodeConePtr_t LeafNodeCone::self(void) const { return weak_ptr_.lock(); }
 
 void LeafNodeCone::setRadius(const float& radius) {
-  cone_ptr_->setRadius(radius);
-  redrawShape();
+  radius_ = radius;
+  updateShapeTransform();
 }
 
 void LeafNodeCone::setHeight(const float& height) {
-  cone_ptr_->setHeight(height);
-  redrawShape();
+  height_ = height;
+  updateShapeTransform();
 }
 
-LeafNodeCone::~LeafNodeCone() {
-  /* Proper deletion of all tree scene */
-  geode_ptr_->removeDrawable(shape_drawable_ptr_);
-  shape_drawable_ptr_ = NULL;
-
-  this->asQueue()->removeChild(geode_ptr_);
-  geode_ptr_ = NULL;
+void LeafNodeCone::updateShapeTransform() {
+  shape_transform_ptr_->setMatrix(
+      ::osg::Matrix::scale(radius_, radius_, height_));
+  setDirty();
+}
 
+LeafNodeCone::~LeafNodeCone() {
   weak_ptr_.reset();
 }
 
@@ -15,14 +15,8 @@ namespace viewer {
 
 void LeafNodeCylinder::init() {
   /* Create cylinder object */
-  cylinder_ptr_ = new ::osg::Cylinder();
-
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new ::osg::ShapeDrawable(cylinder_ptr_);
-
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
+  radius_ = height_ = 1.f;
+  shape_transform_ptr_ = addUnitShape(UNIT_CYLINDER);
 
   addProperty(FloatProperty::create("Radius",
                                     FloatProperty::getterFromMemberFunction(
@@ -34,13 +28,6 @@ void LeafNodeCylinder::init() {
                                         this, &LeafNodeCylinder::getHeight),
                                     FloatProperty::setterFromMemberFunction(
                                         this, &LeafNodeCylinder::setHeight)));
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
 }
 
 LeafNodeCylinder::LeafNodeCylinder(const std::string& name, const float& radius,
@@ -62,7 +49,7 @@ LeafNodeCylinder::LeafNodeCylinder(const std::string& name, const float& radius,
 }
 
 LeafNodeCylinder::LeafNodeCylinder(const LeafNodeCylinder& other)
-    : NodeDrawable(other) {
+    : NodeDrawable(other.getID()) {
   init();
   setRadius(other.getRadius());
   setHeight(other.getHeight());
@@ -124,23 +111,22 @@ LeafNodeCylinderPtr_t LeafNodeCylinder::self(void) const {
 }
 
 void LeafNodeCylinder::setRadius(const float& radius) {
-  cylinder_ptr_->setRadius(radius);
-  redrawShape();
+  radius_ = radius;
+  updateShapeTransform();
 }
 
 void LeafNodeCylinder::setHeight(const float& height) {
-  cylinder_ptr_->setHeight(height);
-  redrawShape();
+  height_ = height;
+  updateShapeTransform();
 }
 
-LeafNodeCylinder::~LeafNodeCylinder() {
-  /* Proper deletion of all tree scene */
-  geode_ptr_->removeDrawable(shape_drawable_ptr_);
-  shape_drawable_ptr_ = NULL;
-
-  this->asQueue()->removeChild(geode_ptr_);
-  geode_ptr_ = NULL;
+void LeafNodeCylinder::updateShapeTransform() {
+  shape_transform_ptr_->setMatrix(
+      ::osg::Matrix::scale(radius_, radius_, height_));
+  setDirty();
+}
 
+LeafNodeCylinder::~LeafNodeCylinder() {
   weak_ptr_.reset();
 }
 
@@ -7,6 +7,7 @@
 //
 
 #include <gepetto/viewer/leaf-node-face.h>
+#include <gepetto/viewer/texture-cache.h>
 
 #include <osg/CullFace>
 #include <osg/Texture2D>
@@ -193,18 +194,13 @@ void LeafNodeFace::setColor(const osgVector4& color) {
 }
 
 void LeafNodeFace::setTexture(const std::string& image_path) {
-  osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-  // Do not resize image to closest power of two values for width and height
-  texture->setResizeNonPowerOfTwoHint(false);
-  // Disable interpolation between pixels.
-  texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
-  osg::ref_ptr<osg::Image> image = osgDB::readImageFile(image_path);
-  if (!image) {
+  osg::ref_ptr<osg::Texture2D> texture =
+      TextureCache::get(image_path, TextureCache::NEAREST_FILTERING);
+  if (!texture) {
     log() << "couldn't find texture " << image_path << ", quiting."
           << std::endl;
     return;
   }
-  texture->setImage(image);
   osg::Vec2Array* texcoords = new osg::Vec2Array(4);
   (*texcoords)[0].set(0.00f, 0.0f);  // texture coord for vertex 0
   (*texcoords)[1].set(1.00f, 0.0f);  // texture coord for vertex 1
@@ -0,0 +1,349 @@
+//
+//  leaf-node-marker-array.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/leaf-node-marker-array.h>
+
+#include <algorithm>
+#include <osg/Geometry>
+#include <osg/Program>
+#include <osg/Uniform>
+#include <stdexcept>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+/// Unit used to bind the texture buffer of the markers.
+const unsigned int textureUnit = 7;
+
+/// Offsets of the data in the floats of a marker.
+enum { POSITION = 0, ORIENTATION = 4, SCALE = 8, COLOR = 12 };
+const std::size_t floatsPerMarker = 16;
+
+/// The shape matrix places the unit shape in the frame of the marker, which
+/// is then scaled, rotated by a quaternion and translated.
+const char* markerVertexShader =
+    "#version 140\n"
+    "#extension GL_ARB_compatibility : enable\n"
+    "uniform samplerBuffer gv_markers;\n"
+    "uniform mat4 gv_shapeMatrix;\n"
+    "uniform mat3 gv_shapeNormalMatrix;\n"
+    "uniform bool gv_idPass;\n"
+    "uniform vec4 gv_nodeId;\n"
+    "vec3 rotate(vec4 q, vec3 v) {\n"
+    "  return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);\n"
+    "}\n"
+    "void main() {\n"
+    "  int i = 4 * gl_InstanceID;\n"
+    "  vec3 position = texelFetch(gv_markers, i).xyz;\n"
+    "  vec4 orientation = texelFetch(gv_markers, i + 1);\n"
+    "  vec3 scale = texelFetch(gv_markers, i + 2).xyz;\n"
+    "  vec4 markerColor = texelFetch(gv_markers, i + 3);\n"
+    "  vec3 vertex = (gv_shapeMatrix * gl_Vertex).xyz * scale;\n"
+    "  vertex = rotate(orientation, vertex) + position;\n"
+    "  vec3 normal = gv_shapeNormalMatrix * gl_Normal\n"
+    "    / max(abs(scale), vec3(1e-6));\n"
+    "  normal = normalize(gl_NormalMatrix * rotate(orientation, normal));\n"
+    "  vec4 eyeVertex = gl_ModelViewMatrix * vec4(vertex, 1.0);\n"
+    "  vec3 lightDir = normalize(gl_LightSource[0].position.xyz\n"
+    "    - eyeVertex.xyz * gl_LightSource[0].position.w);\n"
+    "  float diffuse = abs(dot(normal, lightDir));\n"
+    "  vec4 color = markerColor * (gl_LightModel.ambient\n"
+    "    + gl_LightSource[0].ambient + diffuse * gl_LightSource[0].diffuse);\n"
+    "  color.a = markerColor.a;\n"
+    "  if (gv_idPass) color = gv_nodeId;\n"
+    "  gl_FrontColor = color;\n"
+    "  gl_BackColor = color;\n"
+    "  gl_Position = gl_ProjectionMatrix * eyeVertex;\n"
+    "}\n";
+
+osg::Program* markerProgram() {
+  static osg::ref_ptr<osg::Program> program;
+  if (!program) {
+    program = new osg::Program;
+    program->setName("gv_markerArray");
+    program->addShader(
+        new osg::Shader(osg::Shader::VERTEX, markerVertexShader));
+  }
+  return program.get();
+}
+
+/// The bounding box of the markers, shared by the geometries of the shape.
+struct MarkerBound : osg::Drawable::ComputeBoundingBoxCallback {
+  osg::BoundingBox box;
+
+  virtual osg::BoundingBox computeBound(const osg::Drawable&) const {
+    return box;
+  }
+};
+}  // namespace
+
+/* Declaration of private function members */
+
+void LeafNodeMarkerArray::init() {
+  markers_buffer_ = new ::osg::TextureBuffer;
+  markers_buffer_->setInternalFormat(GL_RGBA32F_ARB);
+  bound_ = new MarkerBound;
+
+  geode_ptr_ = new ::osg::Geode;
+  // The geometries are those of a single marker, which are meaningless for
+  // intersections.
+  geode_ptr_->setNodeMask(0x0);
+
+  // The unit shapes are along Z and the arrow is along X.
+  const ::osg::Matrix toX(::osg::Matrix::rotate(::osg::PI_2, ::osg::Y_AXIS));
+  switch (shape_) {
+    case SPHERE:
+      addShape(UNIT_SPHERE, ::osg::Matrix::scale(0.5, 0.5, 0.5));
+      break;
+    case BOX:
+      addShape(UNIT_BOX, ::osg::Matrix::scale(0.5, 0.5, 0.5));
+      break;
+    case CYLINDER:
+      addShape(UNIT_CYLINDER, ::osg::Matrix::scale(0.5, 0.5, 1.));
+      break;
+    case ARROW:
+      addShape(UNIT_CYLINDER, ::osg::Matrix::scale(0.25, 0.25, 0.75) * toX *
+                                  ::osg::Matrix::translate(0.375, 0., 0.));
+      // The center of the cone is at a quarter of its height.
+      addShape(UNIT_CONE, ::osg::Matrix::scale(0.5, 0.5, 0.25) * toX *
+                              ::osg::Matrix::translate(0.8125, 0., 0.));
+      break;
+  }
+
+  ::osg::StateSet* ss = geode_ptr_->getOrCreateStateSet();
+  // The program is protected so that the id buffer of the windows is
+  // rendered with the marker transforms, see gv_idPass.
+  ss->setAttributeAndModes(
+      markerProgram(),
+      ::osg::StateAttribute::ON | ::osg::StateAttribute::PROTECTED);
+  ss->setTextureAttribute(textureUnit, markers_buffer_.get());
+  ss->addUniform(new ::osg::Uniform("gv_markers", (int)textureUnit));
+  ss->addUniform(new ::osg::Uniform("gv_idPass", false));
+  /* Allow transparency */
+  ss->setMode(GL_BLEND, ::osg::StateAttribute::ON);
+  this->asQueue()->addChild(geode_ptr_);
+
+  allocate(0);
+}
+
+void LeafNodeMarkerArray::addShape(UnitShape shape,
+                                   const ::osg::Matrix& matrix) {
+  // The copy shares the vertex data of the unit shape. Its primitive sets are
+  // copied because their number of instances is changed.
+  ::osg::GeometryRefPtr geom = new ::osg::Geometry(
+      *unitShape(shape), ::osg::CopyOp::DEEP_COPY_PRIMITIVES);
+  geom->setDataVariance(::osg::Object::DYNAMIC);
+  geom->setComputeBoundingBoxCallback(bound_.get());
+
+  // Normals are transformed by the inverse transpose.
+  const ::osg::Matrix inverse(::osg::Matrix::inverse(matrix));
+  ::osg::StateSet* ss = geom->getOrCreateStateSet();
+  ss->addUniform(
+      new ::osg::Uniform("gv_shapeMatrix", ::osg::Matrixf(matrix)));
+  ss->addUniform(new ::osg::Uniform(
+      "gv_shapeNormalMatrix",
+      ::osg::Matrix3(inverse(0, 0), inverse(1, 0), inverse(2, 0),
+                     inverse(0, 1), inverse(1, 1), inverse(2, 1),
+                     inverse(0, 2), inverse(1, 2), inverse(2, 2))));
+
+  geode_ptr_->addDrawable(geom);
+  geometries_.push_back(geom);
+}
+
+void LeafNodeMarkerArray::allocate(std::size_t num) {
+  ::osg::ref_ptr< ::osg::Image> markers = new ::osg::Image;
+  // A texture buffer cannot be empty.
+  markers->allocateImage((int)(4 * std::max<std::size_t>(num, 1)), 1, 1,
+                         GL_RGBA, GL_FLOAT);
+  markers->setInternalTextureFormat(GL_RGBA32F_ARB);
+
+  float* data = reinterpret_cast<float*>(markers->data());
+  const std::size_t kept = std::min(num, num_markers_);
+  if (kept > 0) std::copy(marker(0), marker(kept), data);
+  const osgVector4 color = getColor();
+  const float defaults[floatsPerMarker] = {
+      0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f,
+      1.f, 1.f, 1.f, 1.f, color[0], color[1], color[2], color[3]};
+  for (std::size_t i = kept; i < num; ++i)
+    std::copy(defaults, defaults + floatsPerMarker,
+              data + i * floatsPerMarker);
+
+  markers_ = markers;
+  markers_buffer_->setImage(markers_.get());
+  num_markers_ = num;
+  for (std::size_t i = 0; i < geometries_.size(); ++i) {
+    for (unsigned int j = 0; j < geometries_[i]->getNumPrimitiveSets(); ++j) {
+      geometries_[i]->getPrimitiveSet(j)->setNumInstances((int)num);
+      geometries_[i]->getPrimitiveSet(j)->dirty();
+    }
+  }
+  // A number of instances equal to zero means a non-instanced draw.
+  geode_ptr_->setNodeMask(num == 0 ? 0x0 : VisibilityBit);
+}
+
+float* LeafNodeMarkerArray::marker(std::size_t i) {
+  return reinterpret_cast<float*>(markers_->data()) + i * floatsPerMarker;
+}
+
+void LeafNodeMarkerArray::markersChanged(bool moved) {
+  markers_->dirty();
+  if (moved) {
+    ::osg::BoundingBox& box = static_cast<MarkerBound*>(bound_.get())->box;
+    box.init();
+    for (std::size_t i = 0; i < num_markers_; ++i) {
+      const float* m = marker(i);
+      const osgVector3 position(m[POSITION], m[POSITION + 1],
+                                m[POSITION + 2]);
+      // The markers fit in a sphere of this radius.
+      const float r =
+          osgVector3(m[SCALE], m[SCALE + 1], m[SCALE + 2]).length();
+      box.expandBy(position - osgVector3(r, r, r));
+      box.expandBy(position + osgVector3(r, r, r));
+    }
+    for (std::size_t i = 0; i < geometries_.size(); ++i)
+      geometries_[i]->dirtyBound();
+    geode_ptr_->dirtyBound();
+  }
+  setDirty();
+}
+
+void LeafNodeMarkerArray::updateTransparency() {
+  float alpha = 1.f;
+  for (std::size_t i = 0; i < num_markers_; ++i)
+    alpha = std::min(alpha, marker(i)[COLOR + 3]);
+  setTransparentRenderingBin(alpha < Node::TransparencyRenderingBinThreshold);
+}
+
+/* End of declaration of private function members */
+
+/* Declaration of protected function members */
+
+LeafNodeMarkerArray::LeafNodeMarkerArray(const std::string& name, Shape shape,
+                                         const osgVector4& color)
+    : NodeDrawable(name), shape_(shape), num_markers_(0) {
+  init();
+  setColor(color);
+}
+
+LeafNodeMarkerArray::LeafNodeMarkerArray(const LeafNodeMarkerArray& other)
+    : NodeDrawable(other.getID()), shape_(other.shape_), num_markers_(0) {
+  init();
+  NodeDrawable::setColor(other.getColor());
+  allocate(other.num_markers_);
+  const float* data = reinterpret_cast<const float*>(other.markers_->data());
+  std::copy(data, data + num_markers_ * floatsPerMarker, marker(0));
+  updateTransparency();
+  markersChanged(true);
+}
+
+void LeafNodeMarkerArray::initWeakPtr(
+    LeafNodeMarkerArrayWeakPtr other_weak_ptr) {
+  weak_ptr_ = other_weak_ptr;
+}
+
+LeafNodeMarkerArrayPtr_t LeafNodeMarkerArray::create(const std::string& name,
+                                                     Shape shape,
+                                                     const osgVector4& color) {
+  LeafNodeMarkerArrayPtr_t shared_ptr(
+      new LeafNodeMarkerArray(name, shape, color));
+
+  // Add reference to itself
+  shared_ptr->initWeakPtr(shared_ptr);
+
+  return shared_ptr;
+}
+
+LeafNodeMarkerArrayPtr_t LeafNodeMarkerArray::createCopy(
+    LeafNodeMarkerArrayPtr_t other) {
+  LeafNodeMarkerArrayPtr_t shared_ptr(new LeafNodeMarkerArray(*other));
+
+  // Add reference to itself
+  shared_ptr->initWeakPtr(shared_ptr);
+
+  return shared_ptr;
+}
+
+/* End of declaration of protected function members */
+
+/* Declaration of public function members */
+
+LeafNodeMarkerArrayPtr_t LeafNodeMarkerArray::clone(void) const {
+  return LeafNodeMarkerArray::createCopy(weak_ptr_.lock());
+}
+
+LeafNodeMarkerArrayPtr_t LeafNodeMarkerArray::self(void) const {
+  return weak_ptr_.lock();
+}
+
+void LeafNodeMarkerArray::setNumMarkers(std::size_t num) {
+  if (num == num_markers_) return;
+  allocate(num);
+  markersChanged(true);
+}
+
+void LeafNodeMarkerArray::setPoses(const float* poses, std::size_t num) {
+  if (num != num_markers_) allocate(num);
+  for (std::size_t i = 0; i < num; ++i) {
+    const float* pose = poses + 7 * i;
+    float* m = marker(i);
+    std::copy(pose, pose + 3, m + POSITION);
+    std::copy(pose + 3, pose + 7, m + ORIENTATION);
+  }
+  markersChanged(true);
+}
+
+void LeafNodeMarkerArray::setPoses(const std::vector<Configuration>& poses) {
+  std::vector<float> data(7 * poses.size());
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    float* pose = &data[7 * i];
+    for (int k = 0; k < 3; ++k) pose[k] = poses[i].position[k];
+    for (int k = 0; k < 4; ++k) pose[3 + k] = (float)poses[i].quat[k];
+  }
+  setPoses(data.data(), poses.size());
+}
+
+void LeafNodeMarkerArray::setScales(const float* scales, std::size_t num) {
+  if (num != num_markers_)
+    throw std::invalid_argument(
+        "The number of scales must be equal to the number of markers");
+  for (std::size_t i = 0; i < num; ++i)
+    std::copy(scales + 3 * i, scales + 3 * i + 3, marker(i) + SCALE);
+  markersChanged(true);
+}
+
+void LeafNodeMarkerArray::setScales(const std::vector<osgVector3>& scales) {
+  setScales(scales.empty() ? NULL : scales[0].ptr(), scales.size());
+}
+
+void LeafNodeMarkerArray::setColors(const float* colors, std::size_t num) {
+  if (num != num_markers_)
+    throw std::invalid_argument(
+        "The number of colors must be equal to the number of markers");
+  for (std::size_t i = 0; i < num; ++i)
+    std::copy(colors + 4 * i, colors + 4 * i + 4, marker(i) + COLOR);
+  updateTransparency();
+  markersChanged(false);
+}
+
+void LeafNodeMarkerArray::setColors(const std::vector<osgVector4>& colors) {
+  setColors(colors.empty() ? NULL : colors[0].ptr(), colors.size());
+}
+
+void LeafNodeMarkerArray::setColor(const osgVector4& color) {
+  NodeDrawable::setColor(color);
+  for (std::size_t i = 0; i < num_markers_; ++i)
+    std::copy(color.ptr(), color.ptr() + 4, marker(i) + COLOR);
+  markersChanged(false);
+}
+
+LeafNodeMarkerArray::~LeafNodeMarkerArray() { weak_ptr_.reset(); }
+
+/* End of declaration of public function members */
+
+} /* namespace viewer */
+
+} /* namespace gepetto */
@@ -7,7 +7,10 @@
 //
 
 #include <gepetto/viewer/leaf-node-mesh.h>
+#include <gepetto/viewer/texture-cache.h>
 
+#include <OpenThreads/Thread>
+#include <osg/KdTree>
 #include <osg/Texture2D>
 #include <osgDB/ReadFile>
 
@@ -15,6 +18,75 @@
 
 namespace gepetto {
 namespace viewer {
+namespace {
+/// Build the KD-tree of a copy of a geometry.
+class KdTreeThread : public OpenThreads::Thread {
+ public:
+  KdTreeThread(const osg::Geometry& geom)
+      // The arrays and the primitive sets are shared, the list of primitive
+      // sets is not.
+      : geom_(new osg::Geometry(geom, osg::CopyOp::SHALLOW_COPY)) {}
+
+  virtual void run() {
+    osg::KdTree::BuildOptions options;
+    kdTree = new osg::KdTree;
+    if (!kdTree->build(options, geom_.get())) kdTree = NULL;
+  }
+
+  osg::ref_ptr<osg::KdTree> kdTree;
+
+ private:
+  osg::ref_ptr<osg::Geometry> geom_;
+};
+
+/// Build the KD-tree of a geometry once, so that picking does not scan all
+/// its triangles. The geometry is built by several calls, hence the build
+/// starts at the next update traversal. The tree is built in a background
+/// thread and set at the first update traversal after it is done, unless
+/// the geometry changed in the meantime.
+class BuildKdTree : public osg::Drawable::UpdateCallback {
+ public:
+  BuildKdTree() : thread_(NULL), outdated_(false) {}
+
+  /// The geometry changed since the build started.
+  void invalidate() { outdated_ = true; }
+
+  virtual void update(osg::NodeVisitor*, osg::Drawable* drawable) {
+    osg::ref_ptr<BuildKdTree> self(this);
+    osg::Geometry* geom = drawable->asGeometry();
+    if (thread_ != NULL) {
+      if (thread_->isRunning()) return;
+      thread_->join();
+      osg::ref_ptr<osg::KdTree> kdTree = thread_->kdTree;
+      delete thread_;
+      thread_ = NULL;
+      if (!outdated_) {
+        geom->setShape(kdTree.get());
+        drawable->setUpdateCallback(NULL);
+        return;
+      }
+    }
+    if (geom == NULL || geom->getNumPrimitiveSets() == 0) {
+      drawable->setUpdateCallback(NULL);
+      return;
+    }
+    outdated_ = false;
+    thread_ = new KdTreeThread(*geom);
+    thread_->start();
+  }
+
+ protected:
+  virtual ~BuildKdTree() {
+    if (thread_ == NULL) return;
+    thread_->join();
+    delete thread_;
+  }
+
+ private:
+  KdTreeThread* thread_;
+  bool outdated_;
+};
+}  // namespace
 
 /* Declaration of private function members */
 
@@ -46,6 +118,16 @@ void LeafNodeMesh::init() {
   }
 }
 
+void LeafNodeMesh::invalidateKdTree() {
+  mesh_geometry_ptr_->setShape(NULL);
+  BuildKdTree* build =
+      dynamic_cast<BuildKdTree*>(mesh_geometry_ptr_->getUpdateCallback());
+  if (build != NULL)
+    build->invalidate();
+  else
+    mesh_geometry_ptr_->setUpdateCallback(new BuildKdTree);
+}
+
 LeafNodeMesh::LeafNodeMesh(const std::string& name) : Node(name) { init(); }
 
 LeafNodeMesh::LeafNodeMesh(const std::string& name,
@@ -108,18 +190,16 @@ LeafNodeMeshPtr_t LeafNodeMesh::self(void) const { return weak_ptr_.lock(); }
 void LeafNodeMesh::setColor(const osgVector4& color_diffuse,
                             const osgVector4& color_specular,
                             const osgVector4& color_emissive) {
-  // setColor(collada_ptr_,color);
-  osg::ref_ptr<osg::Material> mat_ptr(new osg::Material);
+  // The material is modified in place so that the color arrays, if any, are
+  // left untouched.
+  osg::Material* mat = getOrCreateMaterial();
   osgVector4 color_zero(0.0f, 0.0f, 0.0f, 0.0f);
-  mat_ptr->setDiffuse(osg::Material::FRONT_AND_BACK, color_diffuse);
-  mat_ptr->setAmbient(osg::Material::FRONT_AND_BACK, color_zero);
-  mat_ptr->setSpecular(osg::Material::FRONT_AND_BACK, color_specular);
-  mat_ptr->setEmission(osg::Material::FRONT_AND_BACK, color_emissive);
-
-  if (mesh_geometry_ptr_->getStateSet()) {
-    mesh_geometry_ptr_->getStateSet()->setAttribute(mat_ptr.get());
-    setDirty();
-  }
+  mat->setColorMode(osg::Material::OFF);
+  mat->setDiffuse(osg::Material::FRONT_AND_BACK, color_diffuse);
+  mat->setAmbient(osg::Material::FRONT_AND_BACK, color_zero);
+  mat->setSpecular(osg::Material::FRONT_AND_BACK, color_specular);
+  mat->setEmission(osg::Material::FRONT_AND_BACK, color_emissive);
+  setDirty();
 }
 void LeafNodeMesh::setColor(const osgVector4& color_diffuse) {
   osgVector4 color_specular(0.0f, 0.0f, 0.0f, 0.0f),
@@ -130,32 +210,33 @@ void LeafNodeMesh::setColor(const osgVector4& color_diffuse) {
 }
 
 void LeafNodeMesh::setAlpha(const float& alpha) {
-  osg::StateSet* ss = mesh_geometry_ptr_->getOrCreateStateSet();
   alpha_ = alpha;
-  osg::Material* mat;
-  if (ss->getAttribute(osg::StateAttribute::MATERIAL))
-    mat = dynamic_cast<osg::Material*>(
-        ss->getAttribute(osg::StateAttribute::MATERIAL));
-  else {
+  getOrCreateMaterial()->setAlpha(osg::Material::FRONT_AND_BACK, alpha);
+  setTransparentRenderingBin(alpha < Node::TransparencyRenderingBinThreshold,
+                             mesh_geometry_ptr_->getOrCreateStateSet());
+  setDirty();
+}
+
+osg::Material* LeafNodeMesh::getOrCreateMaterial() {
+  osg::StateSet* ss = mesh_geometry_ptr_->getOrCreateStateSet();
+  osg::Material* mat = dynamic_cast<osg::Material*>(
+      ss->getAttribute(osg::StateAttribute::MATERIAL));
+  if (mat == NULL) {
     mat = new osg::Material;
     ss->setAttribute(mat);
   }
-  mat->setAlpha(osg::Material::FRONT_AND_BACK, alpha);
-  setTransparentRenderingBin(alpha < Node::TransparencyRenderingBinThreshold,
-                             ss);
-  setDirty();
+  // The material is modified after the scene graph is compiled.
+  mat->setDataVariance(osg::Object::DYNAMIC);
+  return mat;
 }
 
 void LeafNodeMesh::setTexture(const std::string& image_path) {
-  osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-  texture->setDataVariance(osg::Object::DYNAMIC);
-  osg::ref_ptr<osg::Image> image = osgDB::readImageFile(image_path);
-  if (!image) {
+  osg::ref_ptr<osg::Texture2D> texture = TextureCache::get(image_path);
+  if (!texture) {
     log() << "couldn't find texture " << image_path << ", quiting."
           << std::endl;
     return;
   }
-  texture->setImage(image);
   mesh_geometry_ptr_->getStateSet()->setTextureAttributeAndModes(
       0, texture, osg::StateAttribute::ON);
   setDirty();
@@ -165,11 +246,13 @@ osg::ref_ptr<osg::Node> LeafNodeMesh::getOsgNode() const { return geode_ptr_; }
 
 void LeafNodeMesh::setVertexArray(osg::Vec3ArrayRefPtr arrayOfVertices) {
   mesh_geometry_ptr_->setVertexArray(arrayOfVertices);
+  invalidateKdTree();
   setDirty();
 }
 
 void LeafNodeMesh::addPrimitiveSet(osg::DrawElementsUInt* aPrimitiveSet) {
   mesh_geometry_ptr_->addPrimitiveSet(aPrimitiveSet);
+  invalidateKdTree();
   setDirty();
 }
 
@@ -15,21 +15,7 @@ namespace viewer {
 
 void LeafNodeSphere::init() {
   /* Create sphere object */
-  sphere_ptr_ = new ::osg::Sphere();
-
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new ::osg::ShapeDrawable(sphere_ptr_);
-
-  /* Create Geode for adding ShapeDrawable */
-  geode_ptr_ = new osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
-
-  /* Create PositionAttitudeTransform */
-  this->asQueue()->addChild(geode_ptr_);
-
-  /* Allow transparency */
-  geode_ptr_->getOrCreateStateSet()->setMode(GL_BLEND,
-                                             ::osg::StateAttribute::ON);
+  shape_transform_ptr_ = addUnitShape(UNIT_SPHERE);
 
   RangedFloatProperty::Ptr_t radiusProp = RangedFloatProperty::create(
       "Radius", this, &LeafNodeSphere::getRadius, &LeafNodeSphere::setRadius);
@@ -56,7 +42,7 @@ LeafNodeSphere::LeafNodeSphere(const std::string& name, const float& radius,
 
 LeafNodeSphere::LeafNodeSphere(const std::string& name,
                                const LeafNodeSphere& other)
-    : NodeDrawable(other) {
+    : NodeDrawable(other.getID()) {
   setID(name);
   init();
   setRadius(other.getRadius());
@@ -114,18 +100,12 @@ LeafNodeSpherePtr_t LeafNodeSphere::self(void) const {
 }
 
 void LeafNodeSphere::setRadius(const float& radius) {
-  sphere_ptr_->setRadius(radius);
-  redrawShape();
+  radius_ = radius;
+  shape_transform_ptr_->setMatrix(::osg::Matrix::scale(radius, radius, radius));
+  setDirty();
 }
 
 LeafNodeSphere::~LeafNodeSphere() {
-  /* Proper deletion of all tree scene */
-  geode_ptr_->removeDrawable(shape_drawable_ptr_);
-  shape_drawable_ptr_ = NULL;
-
-  this->asQueue()->removeChild(geode_ptr_);
-  geode_ptr_ = NULL;
-
   weak_ptr_.reset();
 }
 
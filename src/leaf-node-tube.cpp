@@ -0,0 +1,248 @@
+//
+//  leaf-node-tube.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/leaf-node-tube.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+/// Number of vertices around the tube.
+const unsigned int tubeSides = 16;
+
+/// Directions of the vertices of a ring, in the frame of the ring.
+struct RingDirections {
+  float cosines[tubeSides], sines[tubeSides];
+
+  RingDirections() {
+    for (unsigned int k = 0; k < tubeSides; ++k) {
+      float theta = 2 * (float)M_PI * (float)k / (float)tubeSides;
+      cosines[k] = std::cos(theta);
+      sines[k] = std::sin(theta);
+    }
+  }
+};
+const RingDirections ring;
+
+/// A unit vector orthogonal to v.
+osgVector3 orthogonal(const osgVector3& v) {
+  osgVector3 o = (std::fabs(v.x()) < 0.9f) ? osgVector3(1, 0, 0) ^ v
+                                          : osgVector3(0, 1, 0) ^ v;
+  o.normalize();
+  return o;
+}
+}  // namespace
+
+/* Declaration of private function members */
+
+void LeafNodeTube::init() {
+  vertices_ = new ::osg::Vec3Array;
+  normals_ = new ::osg::Vec3Array;
+  triangles_ = new ::osg::DrawElementsUInt(GL_TRIANGLES);
+
+  tube_ptr_ = new ::osg::Geometry;
+  tube_ptr_->setDataVariance(::osg::Object::DYNAMIC);
+  tube_ptr_->setUseDisplayList(false);
+  tube_ptr_->setUseVertexBufferObjects(true);
+  tube_ptr_->setVertexArray(vertices_);
+  tube_ptr_->setNormalArray(normals_, ::osg::Array::BIND_PER_VERTEX);
+  tube_ptr_->setColorArray(colors_.get(), ::osg::Array::BIND_OVERALL);
+  tube_ptr_->addPrimitiveSet(triangles_);
+
+  geode_ptr_ = new ::osg::Geode;
+  geode_ptr_->addDrawable(tube_ptr_);
+  this->asQueue()->addChild(geode_ptr_);
+
+  RangedFloatProperty::Ptr_t radiusProp = RangedFloatProperty::create(
+      "Radius", this, &LeafNodeTube::getRadius, &LeafNodeTube::setRadius);
+  radiusProp->min = 0.f;
+  radiusProp->step = 0.01f;
+  radiusProp->adaptiveDecimal = true;
+  addProperty(radiusProp);
+}
+
+LeafNodeTube::LeafNodeTube(const std::string& name,
+                           const std::vector<osgVector3>& points,
+                           const float& radius, const osgVector4& color)
+    : NodeDrawable(name), radius_(radius) {
+  init();
+  setPoints(points);
+  setColor(color);
+}
+
+LeafNodeTube::LeafNodeTube(const LeafNodeTube& other)
+    : NodeDrawable(other.getID()), radius_(other.radius_) {
+  init();
+  setPoints(other.points_);
+  setRadii(other.radii_);
+  setColor(other.getColor());
+}
+
+void LeafNodeTube::initWeakPtr(LeafNodeTubeWeakPtr other_weak_ptr) {
+  weak_ptr_ = other_weak_ptr;
+}
+
+/* The vertices are made of one ring of tubeSides vertices per point, then of
+ * the center and the ring of each end disk, which have their own normals. */
+void LeafNodeTube::buildTriangles() {
+  const unsigned int K = tubeSides;
+  const unsigned int M = (unsigned int)points_.size();
+  const unsigned int cap0 = M * K, cap1 = cap0 + K + 1;
+
+  vertices_->resize(M * K + 2 * (K + 1));
+  normals_->resize(vertices_->size());
+
+  triangles_->clear();
+  triangles_->reserve(6 * K * (M - 1) + 6 * K);
+  for (unsigned int k = 0; k < K; ++k) {
+    unsigned int k1 = (k + 1) % K;
+    for (unsigned int r = 0; r + 1 < M; ++r) {
+      unsigned int a = r * K, b = a + K;
+      triangles_->push_back(a + k);
+      triangles_->push_back(a + k1);
+      triangles_->push_back(b + k);
+      triangles_->push_back(a + k1);
+      triangles_->push_back(b + k1);
+      triangles_->push_back(b + k);
+    }
+    triangles_->push_back(cap0);
+    triangles_->push_back(cap0 + 1 + k1);
+    triangles_->push_back(cap0 + 1 + k);
+    triangles_->push_back(cap1);
+    triangles_->push_back(cap1 + 1 + k);
+    triangles_->push_back(cap1 + 1 + k1);
+  }
+  triangles_->dirty();
+}
+
+void LeafNodeTube::updateVertices() {
+  const unsigned int K = tubeSides;
+  const std::size_t M = points_.size();
+  osgVector3* vertices = &vertices_->front();
+  osgVector3* normals = &normals_->front();
+
+  // Frames are transported along the polyline: each normal is the previous
+  // one projected on the plane orthogonal to the tangent.
+  osgVector3 tangent, first, normal;
+  for (std::size_t i = 0; i < M; ++i) {
+    const osgVector3& next = points_[i + 1 < M ? i + 1 : i];
+    const osgVector3& previous = points_[i > 0 ? i - 1 : i];
+    osgVector3 t = next - previous;
+    if (t.normalize() > 0) tangent = t;
+    if (i == 0) {
+      if (tangent.length2() == 0) tangent.set(1, 0, 0);
+      first = tangent;
+      normal = orthogonal(tangent);
+    } else {
+      normal -= tangent * (normal * tangent);
+      if (normal.normalize() == 0) normal = orthogonal(tangent);
+    }
+    const osgVector3 binormal = tangent ^ normal;
+    const float radius = radii_.empty() ? radius_ : radii_[i];
+    const osgVector3& center = points_[i];
+    for (unsigned int k = 0; k < K; ++k) {
+      const osgVector3 n = normal * ring.cosines[k] + binormal * ring.sines[k];
+      vertices[k] = center + n * radius;
+      normals[k] = n;
+    }
+    vertices += K;
+    normals += K;
+  }
+
+  // End disks.
+  const osgVector3* ring0 = &vertices_->front();
+  const osgVector3* ring1 = ring0 + (M - 1) * K;
+  *vertices++ = points_.front();
+  *normals++ = -first;
+  for (unsigned int k = 0; k < K; ++k) {
+    *vertices++ = ring0[k];
+    *normals++ = -first;
+  }
+  *vertices++ = points_.back();
+  *normals++ = tangent;
+  for (unsigned int k = 0; k < K; ++k) {
+    *vertices++ = ring1[k];
+    *normals++ = tangent;
+  }
+
+  vertices_->dirty();
+  normals_->dirty();
+  tube_ptr_->dirtyBound();
+  geode_ptr_->dirtyBound();
+  setDirty();
+}
+
+/* End of declaration of private function members */
+
+/* Declaration of protected function members */
+
+LeafNodeTubePtr_t LeafNodeTube::create(const std::string& name,
+                                       const std::vector<osgVector3>& points,
+                                       const float& radius,
+                                       const osgVector4& color) {
+  LeafNodeTubePtr_t shared_ptr(new LeafNodeTube(name, points, radius, color));
+
+  // Add reference to itself
+  shared_ptr->initWeakPtr(shared_ptr);
+
+  return shared_ptr;
+}
+
+LeafNodeTubePtr_t LeafNodeTube::createCopy(LeafNodeTubePtr_t other) {
+  LeafNodeTubePtr_t shared_ptr(new LeafNodeTube(*other));
+
+  // Add reference to itself
+  shared_ptr->initWeakPtr(shared_ptr);
+
+  return shared_ptr;
+}
+
+/* End of declaration of protected function members */
+
+/* Declaration of public function members */
+
+LeafNodeTubePtr_t LeafNodeTube::clone(void) const {
+  return LeafNodeTube::createCopy(weak_ptr_.lock());
+}
+
+LeafNodeTubePtr_t LeafNodeTube::self(void) const { return weak_ptr_.lock(); }
+
+void LeafNodeTube::setPoints(const std::vector<osgVector3>& points) {
+  if (points.size() < 2)
+    throw std::invalid_argument("A tube needs at least two points");
+  bool sizeChanged = (points.size() != points_.size());
+  points_ = points;
+  if (sizeChanged) {
+    radii_.clear();
+    buildTriangles();
+  }
+  updateVertices();
+}
+
+void LeafNodeTube::setRadii(const std::vector<float>& radii) {
+  if (!radii.empty() && radii.size() != points_.size())
+    throw std::invalid_argument(
+        "The number of radii must be equal to the number of points");
+  radii_ = radii;
+  updateVertices();
+}
+
+void LeafNodeTube::setRadius(const float& radius) {
+  radius_ = radius;
+  radii_.clear();
+  updateVertices();
+}
+
+LeafNodeTube::~LeafNodeTube() { weak_ptr_.reset(); }
+
+/* End of declaration of public function members */
+
+} /* namespace viewer */
+
+} /* namespace gepetto */
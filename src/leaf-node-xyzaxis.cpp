@@ -92,14 +92,12 @@ void LeafNodeXYZAxis::init() {
   static osg::ref_ptr<osgText::Font> font = defaultFont();
 
   /* Create sphere object */
-  sphere_ptr_ = new ::osg::Sphere();
-  sphere_ptr_->setRadius(getRadius());
-  /* Set ShapeDrawable */
-  shape_drawable_ptr_ = new ::osg::ShapeDrawable(sphere_ptr_);
+  sphere_ptr_ = addUnitShape(UNIT_SPHERE);
+  sphere_ptr_->setMatrix(
+      ::osg::Matrix::scale(getRadius(), getRadius(), getRadius()));
 
-  /* Create Geode for adding ShapeDrawable */
+  /* Create Geode for the axis */
   geode_ptr_ = new osg::Geode();
-  geode_ptr_->addDrawable(shape_drawable_ptr_);
   if (sizeAxis_ > 0) {  // optimisation of memory consumption : doesn't create
                         // the axis instead of creating axis with size "0"
                         /* create the axis : */
@@ -190,9 +188,12 @@ LeafNodeXYZAxis::LeafNodeXYZAxis(const std::string& name,
 }
 
 LeafNodeXYZAxis::LeafNodeXYZAxis(const LeafNodeXYZAxis& other)
-    : NodeDrawable(other) {
+    : NodeDrawable(other.getID()) {
+  setRadius(other.radius_);
+  setSizeAxis(other.sizeAxis_);
+
   init();
-  // TODO
+  setColor(other.getColor());
 }
 
 void LeafNodeXYZAxis::initWeakPtr(LeafNodeXYZAxisWeakPtr other_weak_ptr) {
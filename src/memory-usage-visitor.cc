@@ -0,0 +1,171 @@
+// Copyright (c) 2026, LAAS-CNRS
+//
+// This file is part of gepetto-viewer.
+// gepetto-viewer is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// gepetto-viewer is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// gepetto-viewer. If not, see <http://www.gnu.org/licenses/>.
+
+#include <gepetto/viewer/memory-usage-visitor.h>
+#include <gepetto/viewer/node.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+#include <osg/Texture>
+#include <osg/Version>
+#include <stdexcept>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+/// Count the OSG data below the root of a Node, stopping at the roots of
+/// its children.
+class OsgMemoryUsage : public osg::NodeVisitor {
+ public:
+  OsgMemoryUsage(const osg::Node* root,
+                 std::set<const osg::Referenced*>& counted, MemoryUsage& usage)
+      : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN),
+        root_(root),
+        counted_(counted),
+        usage_(usage) {
+    // Hidden nodes use memory too.
+    setNodeMaskOverride(~0x0u);
+  }
+
+  void apply(osg::Node& node) {
+    // Children Node are counted separately.
+    if (&node != root_ && (node.getNodeMask() & NodeBit)) return;
+    countStateSet(node.getStateSet());
+    traverse(node);
+  }
+
+  void apply(osg::Geode& geode) {
+    if (!firstTime(&geode)) return;
+    usage_.cpuBytes += sizeof(osg::Geode);
+    countStateSet(geode.getStateSet());
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i)
+      countDrawable(geode.getDrawable(i));
+  }
+
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 3, 2)
+  void apply(osg::Drawable& drawable) { countDrawable(&drawable); }
+#endif
+
+ private:
+  const osg::Node* root_;
+  std::set<const osg::Referenced*>& counted_;
+  MemoryUsage& usage_;
+
+  bool firstTime(const osg::Referenced* object) {
+    return counted_.insert(object).second;
+  }
+
+  void countData(const osg::BufferData* data, bool onGpu) {
+    if (data == NULL || !firstTime(data)) return;
+    std::size_t size = data->getTotalDataSize();
+    usage_.cpuBytes += size;
+    if (onGpu) usage_.gpuBytes += size;
+  }
+
+  void countDrawable(const osg::Drawable* drawable) {
+    if (drawable == NULL || !firstTime(drawable)) return;
+    countStateSet(drawable->getStateSet());
+    const osg::Geometry* geom = drawable->asGeometry();
+    if (geom == NULL) {
+      usage_.cpuBytes += sizeof(osg::Drawable);
+      return;
+    }
+    usage_.cpuBytes += sizeof(osg::Geometry);
+    bool onGpu =
+        geom->getUseVertexBufferObjects() || geom->getUseDisplayList();
+    countData(geom->getVertexArray(), onGpu);
+    countData(geom->getNormalArray(), onGpu);
+    countData(geom->getColorArray(), onGpu);
+    countData(geom->getSecondaryColorArray(), onGpu);
+    countData(geom->getFogCoordArray(), onGpu);
+    for (unsigned int i = 0; i < geom->getNumTexCoordArrays(); ++i)
+      countData(geom->getTexCoordArray(i), onGpu);
+    for (unsigned int i = 0; i < geom->getNumVertexAttribArrays(); ++i)
+      countData(geom->getVertexAttribArray(i), onGpu);
+    for (unsigned int i = 0; i < geom->getNumPrimitiveSets(); ++i)
+      countData(geom->getPrimitiveSet(i), onGpu);
+  }
+
+  void countStateSet(const osg::StateSet* ss) {
+    if (ss == NULL || !firstTime(ss)) return;
+    usage_.cpuBytes += sizeof(osg::StateSet);
+    for (unsigned int unit = 0; unit < ss->getTextureAttributeList().size();
+         ++unit) {
+      const osg::Texture* texture = dynamic_cast<const osg::Texture*>(
+          ss->getTextureAttribute(unit, osg::StateAttribute::TEXTURE));
+      if (texture != NULL) countTexture(texture);
+    }
+  }
+
+  void countTexture(const osg::Texture* texture) {
+    if (!firstTime(texture)) return;
+    for (unsigned int i = 0; i < texture->getNumImages(); ++i) {
+      const osg::Image* image = texture->getImage(i);
+      if (image == NULL) continue;
+      std::size_t size = image->getTotalSizeInBytesIncludingMipmaps();
+      if (firstTime(image)) usage_.cpuBytes += size;
+
+      std::size_t gpu = size;
+      // Mipmaps generated by the driver add a third of the base level.
+      osg::Texture::FilterMode minFilter =
+          texture->getFilter(osg::Texture::MIN_FILTER);
+      if (!image->isMipmap() && minFilter != osg::Texture::LINEAR &&
+          minFilter != osg::Texture::NEAREST)
+        gpu += size / 3;
+      // Compression by the driver (see TextureCache) divides the size by
+      // four to eight. Assume four.
+      osg::Texture::InternalFormatMode mode = texture->getInternalFormatMode();
+      if (!image->isCompressed() &&
+          mode != osg::Texture::USE_IMAGE_DATA_FORMAT &&
+          mode != osg::Texture::USE_USER_DEFINED_FORMAT)
+        gpu /= 4;
+      usage_.gpuBytes += gpu;
+    }
+  }
+};
+}  // namespace
+
+void MemoryUsageVisitor::apply(Node& node) {
+  // A node in several groups is counted once.
+  std::pair<Usages_t::iterator, bool> res =
+      usages_.insert(std::make_pair(&node, MemoryUsage()));
+  if (!res.second) return;
+  MemoryUsage& usage = res.first->second;
+
+  usage.cpuBytes = node.getOverheadBytes();
+  osg::GroupRefPtr root = node.asGroup();
+  OsgMemoryUsage osgVisitor(root.get(), counted_, usage);
+  root->accept(osgVisitor);
+
+  std::size_t cpu0 = total_.cpuBytes, gpu0 = total_.gpuBytes;
+  total_.cpuBytes += usage.cpuBytes;
+  total_.gpuBytes += usage.gpuBytes;
+  traverse(node);
+  usage.subtreeCpuBytes = total_.cpuBytes - cpu0;
+  usage.subtreeGpuBytes = total_.gpuBytes - gpu0;
+  total_.subtreeCpuBytes = total_.cpuBytes;
+  total_.subtreeGpuBytes = total_.gpuBytes;
+}
+
+const MemoryUsage& MemoryUsageVisitor::usage(const Node& node) const {
+  Usages_t::const_iterator it = usages_.find(&node);
+  if (it == usages_.end())
+    throw std::invalid_argument("Node " + node.getID() + " was not visited.");
+  return it->second;
+}
+} /* namespace viewer */
+} /* namespace gepetto */
@@ -0,0 +1,291 @@
+//
+//  mesh-instancer.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/mesh-instancer.h>
+
+#include <osg/Geometry>
+#include <osg/NodeVisitor>
+#include <osg/Program>
+#include <osg/Texture>
+#include <osg/Version>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+/// The instance transform maps the world frame of the mesh held by the
+/// instancer to the world frame of the instance. As the mesh may contain
+/// transforms, it must be applied in world frame, which is why the view matrix
+/// appears in the computation of the model view matrix.
+const char* instancedVertexShader =
+    "#version 140\n"
+    "#extension GL_ARB_compatibility : enable\n"
+    "uniform samplerBuffer gv_instanceMatrices;\n"
+    "uniform mat4 osg_ViewMatrix;\n"
+    "uniform mat4 osg_ViewMatrixInverse;\n"
+    "uniform bool gv_idPass;\n"
+    "void main() {\n"
+    "  int i = 4 * gl_InstanceID;\n"
+    "  mat4 instance = mat4(texelFetch(gv_instanceMatrices, i),\n"
+    "                       texelFetch(gv_instanceMatrices, i + 1),\n"
+    "                       texelFetch(gv_instanceMatrices, i + 2),\n"
+    "                       texelFetch(gv_instanceMatrices, i + 3));\n"
+    "  mat4 modelView = osg_ViewMatrix * instance * osg_ViewMatrixInverse\n"
+    "    * gl_ModelViewMatrix;\n"
+    "  vec4 eyeVertex = modelView * gl_Vertex;\n"
+    "  vec3 normal = normalize(mat3(modelView) * gl_Normal);\n"
+    "  vec3 lightDir = normalize(gl_LightSource[0].position.xyz\n"
+    "    - eyeVertex.xyz * gl_LightSource[0].position.w);\n"
+    "  float diffuse = abs(dot(normal, lightDir));\n"
+    "  vec4 color = gl_FrontLightModelProduct.sceneColor\n"
+    "    + gl_FrontMaterial.ambient * gl_LightSource[0].ambient\n"
+    "    + diffuse * gl_FrontMaterial.diffuse * gl_LightSource[0].diffuse;\n"
+    "  color.a = gl_FrontMaterial.diffuse.a;\n"
+    "  if (gv_idPass) color = vec4(1.0);\n"
+    "  gl_FrontColor = color;\n"
+    "  gl_BackColor = color;\n"
+    "  gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+    "  gl_Position = gl_ProjectionMatrix * eyeVertex;\n"
+    "}\n";
+
+osg::Program* instancedProgram() {
+  static osg::ref_ptr<osg::Program> program;
+  if (!program) {
+    program = new osg::Program;
+    program->setName("gv_instancedMesh");
+    program->addShader(
+        new osg::Shader(osg::Shader::VERTEX, instancedVertexShader));
+  }
+  return program.get();
+}
+
+/// Deactivate culling and collect the primitive sets of the copied mesh.
+class PrepareInstancedMesh : public osg::NodeVisitor {
+ public:
+  std::vector<osg::PrimitiveSet*>& primitives;
+
+  PrepareInstancedMesh(std::vector<osg::PrimitiveSet*>& prims)
+      : NodeVisitor(TRAVERSE_ALL_CHILDREN), primitives(prims) {}
+
+  void apply(osg::Node& node) {
+    // The bounding volume of the mesh does not account for the instances.
+    node.setCullingActive(false);
+    traverse(node);
+  }
+
+  void apply(osg::Geode& geode) {
+    geode.setCullingActive(false);
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i) {
+      osg::Geometry* geom = geode.getDrawable(i)->asGeometry();
+      if (geom == NULL) continue;
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 3, 2)
+      geom->setCullingActive(false);
+#endif
+      geom->setUseDisplayList(false);
+      geom->setUseVertexBufferObjects(true);
+      for (unsigned int j = 0; j < geom->getNumPrimitiveSets(); ++j)
+        primitives.push_back(geom->getPrimitiveSet(j));
+    }
+  }
+};
+
+/// Look for the states which the instanced shader does not support.
+class CheckInstancedMesh : public osg::NodeVisitor {
+ public:
+  bool supported;
+
+  CheckInstancedMesh() : NodeVisitor(TRAVERSE_ALL_CHILDREN), supported(true) {}
+
+  void check(const osg::StateSet* ss) {
+    if (ss == NULL) return;
+    // Only the texture coordinates of unit 0 are forwarded by the shader.
+    const osg::StateSet::TextureAttributeList& textures =
+        ss->getTextureAttributeList();
+    for (std::size_t i = 1; i < textures.size(); ++i)
+      if (!textures[i].empty()) supported = false;
+  }
+
+  void apply(osg::Node& node) {
+    check(node.getStateSet());
+    if (supported) traverse(node);
+  }
+
+  void apply(osg::Geode& geode) {
+    check(geode.getStateSet());
+    for (unsigned int i = 0; supported && i < geode.getNumDrawables(); ++i) {
+      const osg::Drawable* drawable = geode.getDrawable(i);
+      check(drawable->getStateSet());
+      const osg::Geometry* geom = drawable->asGeometry();
+      // The shader colors the vertices with the material.
+      if (geom != NULL && geom->getColorArray() != NULL &&
+          geom->getColorArray()->getBinding() != osg::Array::BIND_OFF &&
+          geom->getColorArray()->getBinding() != osg::Array::BIND_OVERALL)
+        supported = false;
+    }
+  }
+};
+
+struct InstancerUpdateCallback : osg::NodeCallback {
+  void operator()(osg::Node* node, osg::NodeVisitor* nv) {
+    static_cast<MeshInstancer*>(node)->updateInstances();
+    traverse(node, nv);
+  }
+};
+
+/// Whether two optional state sets are equal.
+bool sameState(const osg::StateSet* a, const osg::StateSet* b) {
+  if (a == NULL || b == NULL) return a == b;
+  return a->compare(*b, true) == 0;
+}
+
+/// State set of the node applying the unit scale of a mesh, if any.
+osg::StateSet* scaleState(const LeafNodeColladaPtr_t& leaf) {
+  if (leaf->collada_ptr_ == leaf->mesh_ptr_) return NULL;
+  return leaf->collada_ptr_->getStateSet();
+}
+
+/// Whether the path is visible, not considering its last node.
+bool isPathVisible(const osg::NodePath& path) {
+  for (std::size_t i = 0; i + 1 < path.size(); ++i)
+    if (!(path[i]->getNodeMask() & VisibilityBit)) return false;
+  return true;
+}
+}  // namespace
+
+const unsigned int MeshInstancer::TextureUnit = 7;
+
+MeshInstancer::MeshInstancer(const LeafNodeColladaPtr_t& leaf)
+    : mesh_(leaf->mesh_ptr_), numDrawn_(0) {
+  setName("meshInstancer");
+  setDataVariance(osg::Object::DYNAMIC);
+  setNodeMask(VisibilityBit);
+
+  osg::StateSet* ss = leaf->group_ptr_->getStateSet();
+  if (ss) material_ = ss;
+  // The unit scale goes into the instance transforms, but the state of the
+  // node applying it is kept.
+  mesh_state_ = scaleState(leaf);
+
+  // Primitive sets are copied because their number of instances is changed.
+  // Vertex arrays are shared with the cached mesh.
+  instanced_mesh_ = osg::clone(
+      mesh_.get(), osg::CopyOp::DEEP_COPY_NODES |
+                       osg::CopyOp::DEEP_COPY_DRAWABLES |
+                       osg::CopyOp::DEEP_COPY_PRIMITIVES);
+  PrepareInstancedMesh prepare(primitives_);
+  instanced_mesh_->accept(prepare);
+
+  matrices_buffer_ = new osg::TextureBuffer;
+  matrices_buffer_->setInternalFormat(GL_RGBA32F_ARB);
+
+  osg::ref_ptr<osg::Group> root = new osg::Group;
+  root->setCullingActive(false);
+  root->setNodeMask(0x0);
+  if (mesh_state_) {
+    osg::ref_ptr<osg::Group> meshGroup = new osg::Group;
+    meshGroup->setStateSet(mesh_state_.get());
+    meshGroup->addChild(instanced_mesh_);
+    root->addChild(meshGroup);
+  } else
+    root->addChild(instanced_mesh_);
+  if (material_) root->setStateSet(new osg::StateSet(*material_));
+  osg::StateSet* rss = root->getOrCreateStateSet();
+  // The program is protected so that the id buffer of the windows is
+  // rendered with the instance transforms, see gv_idPass.
+  rss->setAttributeAndModes(
+      instancedProgram(),
+      osg::StateAttribute::ON | osg::StateAttribute::PROTECTED);
+  rss->setTextureAttribute(TextureUnit, matrices_buffer_.get());
+  rss->addUniform(new osg::Uniform("gv_instanceMatrices", (int)TextureUnit));
+  rss->addUniform(new osg::Uniform("gv_idPass", false));
+  addChild(root);
+
+  setUpdateCallback(new InstancerUpdateCallback);
+  addInstance(leaf);
+}
+
+bool MeshInstancer::canInstance(const LeafNodeColladaPtr_t& leaf) {
+  CheckInstancedMesh check;
+  check.check(leaf->group_ptr_->getStateSet());
+  check.check(scaleState(leaf));
+  if (check.supported) leaf->mesh_ptr_->accept(check);
+  return check.supported;
+}
+
+bool MeshInstancer::accepts(const LeafNodeColladaPtr_t& leaf) const {
+  return leaf->mesh_ptr_ == mesh_ &&
+         sameState(leaf->group_ptr_->getStateSet(), material_.get()) &&
+         sameState(scaleState(leaf), mesh_state_.get());
+}
+
+void MeshInstancer::addInstance(const LeafNodeColladaPtr_t& leaf) {
+  instances_.push_back(leaf);
+  leaf->setDrawnByInstancer(true);
+}
+
+void MeshInstancer::clear() {
+  for (Instances_t::iterator it = instances_.begin(); it != instances_.end();
+       ++it) {
+    LeafNodeColladaPtr_t leaf(it->lock());
+    if (leaf) leaf->setDrawnByInstancer(false);
+  }
+  instances_.clear();
+  setNumDrawn(0);
+}
+
+void MeshInstancer::updateInstances() {
+  osg::Matrix toInstancer;
+  osg::MatrixList instancerToWorld(getWorldMatrices());
+  if (!instancerToWorld.empty())
+    toInstancer = osg::Matrix::inverse(instancerToWorld.front());
+
+  if (!matrices_ || matrices_->s() < (int)(4 * instances_.size())) {
+    // The buffer object is only resized when the image changes.
+    matrices_ = new osg::Image;
+    matrices_->allocateImage((int)(4 * instances_.size()), 1, 1, GL_RGBA,
+                             GL_FLOAT);
+    matrices_->setInternalTextureFormat(GL_RGBA32F_ARB);
+    matrices_buffer_->setImage(matrices_.get());
+  }
+  osg::Matrixf* matrices = reinterpret_cast<osg::Matrixf*>(matrices_->data());
+
+  unsigned int n = 0;
+  for (Instances_t::iterator it = instances_.begin(); it != instances_.end();
+       ++it) {
+    LeafNodeColladaPtr_t leaf(it->lock());
+    if (!leaf) continue;
+    // Highlighted nodes and nodes which are not lit are drawn by themselves.
+    bool instanced = (leaf->getHighlightState() == 0 &&
+                      leaf->getLightingMode() == LIGHT_INFLUENCE_ON);
+    leaf->setDrawnByInstancer(instanced);
+    if (!instanced) continue;
+
+    osg::NodePathList paths(leaf->group_ptr_->getParentalNodePaths());
+    if (paths.empty() || !isPathVisible(paths.front())) continue;
+    const float s = leaf->unit_scale_;
+    matrices[n] = toInstancer * osg::Matrix::scale(s, s, s) *
+                  osg::computeLocalToWorld(paths.front());
+    ++n;
+  }
+  matrices_->dirty();
+  setNumDrawn(n);
+}
+
+void MeshInstancer::setNumDrawn(unsigned int n) {
+  if (n == numDrawn_) return;
+  numDrawn_ = n;
+  for (std::size_t i = 0; i < primitives_.size(); ++i) {
+    primitives_[i]->setNumInstances(n);
+    primitives_[i]->dirty();
+  }
+  // A number of instances equal to zero means a non-instanced draw.
+  getChild(0)->setNodeMask(n == 0 ? 0x0 : ~0x0);
+}
+
+MeshInstancer::~MeshInstancer() { clear(); }
+
+} /* namespace viewer */
+} /* namespace gepetto */
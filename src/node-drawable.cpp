@@ -2,14 +2,19 @@
 // Authors: Joseph Mirabel (joseph.mirabel@laas.fr)
 
 #include <gepetto/viewer/node-drawable.h>
+#include <gepetto/viewer/texture-cache.h>
 
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <osg/Texture2D>
-#include <osg/Version>
 #include <osgDB/ReadFile>
 
 namespace gepetto {
 namespace viewer {
 void NodeDrawable::init() {
+  colors_ = new ::osg::Vec4Array(1);
+  colors_->at(0) = osgVector4(1., 1., 1., 1.);
+
   addProperty(Vector4Property::create(
       "Color",
       Vector4Property::getterFromMemberFunction(this, &NodeDrawable::getColor),
@@ -17,40 +22,111 @@ void NodeDrawable::init() {
                                                 &NodeDrawable::setColor)));
 }
 
+::osg::Geometry* NodeDrawable::unitShape(int shape) {
+  static OpenThreads::Mutex mutex;
+  static ::osg::GeometryRefPtr shapes[NB_UNIT_SHAPES];
+
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  if (shapes[shape]) return shapes[shape].get();
+
+  osg::ref_ptr<osg::TessellationHints> hints = new osg::TessellationHints;
+  osg::ref_ptr<osg::Shape> s;
+  switch (shape) {
+    case UNIT_BOX:
+      s = new osg::Box(osgVector3(), 2.f);
+      break;
+    case UNIT_SPHERE:
+      s = new osg::Sphere(osgVector3(), 1.f);
+      break;
+    case UNIT_CYLINDER:
+      s = new osg::Cylinder(osgVector3(), 1.f, 1.f);
+      break;
+    case UNIT_CONE:
+      s = new osg::Cone(osgVector3(), 1.f, 1.f);
+      break;
+    case UNIT_CAPSULE_BODY:
+      s = new osg::Cylinder(osgVector3(), 1.f, 1.f);
+      hints->setCreateTop(false);
+      hints->setCreateBottom(false);
+      break;
+    case UNIT_CAPSULE_TOP:
+      s = new osg::Capsule(osgVector3(), 1.f, 0.f);
+      hints->setCreateBody(false);
+      hints->setCreateBottom(false);
+      break;
+    case UNIT_CAPSULE_BOTTOM:
+      s = new osg::Capsule(osgVector3(), 1.f, 0.f);
+      hints->setCreateBody(false);
+      hints->setCreateTop(false);
+      break;
+  }
+  ::osg::GeometryRefPtr geom = osg::convertShapeToGeometry(*s, hints.get());
+  geom->setName("unitShape");
+  geom->setDataVariance(osg::Object::STATIC);
+  // Display lists would be compiled per node.
+  geom->setUseDisplayList(false);
+  geom->setUseVertexBufferObjects(true);
+  shapes[shape] = geom;
+  return geom.get();
+}
+
+::osg::MatrixTransform* NodeDrawable::addUnitShape(UnitShape shape) {
+  if (!unit_shapes_ptr_) {
+    unit_shapes_ptr_ = new ::osg::Group;
+    unit_shapes_ptr_->setName("unitShapes");
+    ::osg::StateSet* ss = unit_shapes_ptr_->getOrCreateStateSet();
+    /* Allow transparency */
+    ss->setMode(GL_BLEND, ::osg::StateAttribute::ON);
+    // The unit shapes are scaled non uniformly.
+    ss->setMode(GL_NORMALIZE, ::osg::StateAttribute::ON);
+    this->asQueue()->addChild(unit_shapes_ptr_);
+  }
+
+  // The copy shares the vertex data and the primitive sets of the unit shape.
+  ::osg::GeometryRefPtr geom =
+      new ::osg::Geometry(*unitShape(shape), osg::CopyOp::SHALLOW_COPY);
+  geom->setColorArray(colors_.get(), ::osg::Array::BIND_OVERALL);
+
+  ::osg::GeodeRefPtr geode = new ::osg::Geode;
+  geode->addDrawable(geom);
+  ::osg::MatrixTransformRefPtr transform = new ::osg::MatrixTransform;
+  transform->addChild(geode);
+  unit_shapes_ptr_->addChild(transform);
+  return transform.get();
+}
+
 void NodeDrawable::setColor(const osgVector4& color) {
-  shape_drawable_ptr_->setColor(color);
-  redrawShape();
+  colors_->at(0) = color;
+  colors_->dirty();
   setTransparentRenderingBin(color[3] <
                              Node::TransparencyRenderingBinThreshold);
-}
-
-void NodeDrawable::redrawShape() {
-#if OSG_VERSION_GREATER_OR_EQUAL(3, 5, 6)
-  shape_drawable_ptr_->build();
-#else
-  shape_drawable_ptr_->dirtyDisplayList();
-  shape_drawable_ptr_->dirtyBound();
-#endif
   setDirty();
 }
 
-osgVector4 NodeDrawable::getColor() const {
-  return shape_drawable_ptr_->getColor();
-}
+osgVector4 NodeDrawable::getColor() const { return colors_->at(0); }
 
 void NodeDrawable::setTexture(const std::string& image_path) {
-  osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-  texture->setDataVariance(osg::Object::DYNAMIC);
-  osg::ref_ptr<osg::Image> image = osgDB::readImageFile(image_path);
-  if (!image) {
+  osg::ref_ptr<osg::Texture2D> texture = TextureCache::get(image_path);
+  if (!texture) {
     std::cerr << " couldn't find texture " << image_path << ", quiting."
               << std::endl;
     return;
   }
-  texture->setImage(image);
-  geode_ptr_->getStateSet()->setTextureAttributeAndModes(
+  ::osg::Node* node = (unit_shapes_ptr_ ? unit_shapes_ptr_.get()
+                                        : geode_ptr_.get());
+  if (node == NULL) {
+    std::cerr << " no geometry to texture with " << image_path << std::endl;
+    return;
+  }
+  // Some nodes, e.g. tubes, have no state set yet.
+  node->getOrCreateStateSet()->setTextureAttributeAndModes(
       0, texture, osg::StateAttribute::ON);
   setDirty();
 }
+
+NodeDrawable::~NodeDrawable() {
+  if (unit_shapes_ptr_) this->asQueue()->removeChild(unit_shapes_ptr_);
+  unit_shapes_ptr_ = NULL;
+}
 } /* namespace viewer */
 }  // namespace gepetto
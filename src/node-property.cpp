@@ -47,8 +47,33 @@ inline bool invalidType(const std::string& name, T) {
                               details::property_type<T>::to_string());
 }
 
-Property::Property(const std::string& name) : QObject(NULL), name_(name) {
-  setObjectName(QString::fromStdString(name));
+PropertyNotifier::PropertyNotifier(Property* property)
+    : QObject(NULL), property_(property) {
+  setObjectName(QString::fromStdString(property->name()));
+}
+
+bool PropertyNotifier::set(void) { return property_->set(); }
+bool PropertyNotifier::set(const bool& v) { return property_->set(v); }
+bool PropertyNotifier::set(const int& v) { return property_->set(v); }
+bool PropertyNotifier::set(const float& v) { return property_->set(v); }
+bool PropertyNotifier::set(const std::string& v) { return property_->set(v); }
+bool PropertyNotifier::set(const osgVector2& v) { return property_->set(v); }
+bool PropertyNotifier::set(const osgVector3& v) { return property_->set(v); }
+bool PropertyNotifier::set(const osgVector4& v) { return property_->set(v); }
+bool PropertyNotifier::set(const Configuration& v) {
+  return property_->set(v);
+}
+bool PropertyNotifier::set(const double& v) { return property_->set(v); }
+bool PropertyNotifier::set(const QString& v) { return property_->set(v); }
+bool PropertyNotifier::set(const QColor& v) { return property_->set(v); }
+
+Property::Property(const std::string& name) : name_(name), notifier_(NULL) {}
+
+Property::~Property() { delete notifier_; }
+
+PropertyNotifier* Property::notifier() {
+  if (notifier_ == NULL) notifier_ = new PropertyNotifier(this);
+  return notifier_;
 }
 
 template <typename T>
@@ -63,36 +88,61 @@ inline QColor qColor(const osgVector4& v) {
   return QColor::fromRgbF((qreal)v[0], (qreal)v[1], (qreal)v[2], (qreal)v[3]);
 }
 
-#define SET_IMPLEMENTATION(v, emit2)                  \
+#define SET_IMPLEMENTATION(v)                         \
   if (!check_if_value_changed(*this, v)) return true; \
   if (impl_set(v)) {                                  \
-    emit valueChanged(v);                             \
-    emit2;                                            \
+    emitValueChanged(v);                              \
     return true;                                      \
   }                                                   \
   return false
 
 bool Property::set(void) {
   bool b = impl_set();
-  if (b) {
-    emit valueChanged();
+  if (b && notifier_ != NULL) {
+    emit notifier_->valueChanged();
   }
   return b;
 }
-bool Property::set(const bool& v) { SET_IMPLEMENTATION(v, ); }
-bool Property::set(const int& v) { SET_IMPLEMENTATION(v, ); }
-bool Property::set(const float& v) {
-  SET_IMPLEMENTATION(v, emit valueChanged(static_cast<double>(v)));
+bool Property::set(const bool& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const int& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const float& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const std::string& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const osgVector2& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const osgVector3& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const osgVector4& v) { SET_IMPLEMENTATION(v); }
+bool Property::set(const Configuration& v) { SET_IMPLEMENTATION(v); }
+
+// Without notifier, nobody listens to the changes.
+void Property::emitValueChanged(const bool& v) {
+  if (notifier_ != NULL) emit notifier_->valueChanged(v);
+}
+void Property::emitValueChanged(const int& v) {
+  if (notifier_ != NULL) emit notifier_->valueChanged(v);
 }
-bool Property::set(const std::string& v) {
-  SET_IMPLEMENTATION(v, emit valueChanged(QString::fromStdString(v)));
+void Property::emitValueChanged(const float& v) {
+  if (notifier_ == NULL) return;
+  emit notifier_->valueChanged(v);
+  emit notifier_->valueChanged(static_cast<double>(v));
 }
-bool Property::set(const osgVector2& v) { SET_IMPLEMENTATION(v, ); }
-bool Property::set(const osgVector3& v) { SET_IMPLEMENTATION(v, ); }
-bool Property::set(const osgVector4& v) {
-  SET_IMPLEMENTATION(v, emit valueChanged(qColor(v)));
+void Property::emitValueChanged(const std::string& v) {
+  if (notifier_ == NULL) return;
+  emit notifier_->valueChanged(v);
+  emit notifier_->valueChanged(QString::fromStdString(v));
+}
+void Property::emitValueChanged(const osgVector2& v) {
+  if (notifier_ != NULL) emit notifier_->valueChanged(v);
+}
+void Property::emitValueChanged(const osgVector3& v) {
+  if (notifier_ != NULL) emit notifier_->valueChanged(v);
+}
+void Property::emitValueChanged(const osgVector4& v) {
+  if (notifier_ == NULL) return;
+  emit notifier_->valueChanged(v);
+  emit notifier_->valueChanged(qColor(v));
+}
+void Property::emitValueChanged(const Configuration& v) {
+  if (notifier_ != NULL) emit notifier_->valueChanged(v);
 }
-bool Property::set(const Configuration& v) { SET_IMPLEMENTATION(v, ); }
 
 bool Property::get(void) { return impl_get(); }
 bool Property::get(bool& v) { return impl_get(v); }
@@ -165,8 +215,9 @@ QWidget* VoidProperty::guiEditor() {
   QString toolTip(
       "Python:\n"
       "  gui.callVoidProperty(nodeName,\"%1\")");
-  QPushButton* button = new QPushButton(objectName());
-  button->setToolTip(toolTip.arg(objectName()));
+  QString name(QString::fromStdString(name_));
+  QPushButton* button = new QPushButton(name);
+  button->setToolTip(toolTip.arg(name));
   QObject::connect(button, &QAbstractButton::clicked, [this]() { get(); });
   return button;
 }
@@ -193,14 +244,15 @@ QWidget* buildEditor<bool>(Property* prop) {
       "  gui.getBoolProperty(nodeName,\"%1\")\n"
       "  gui.setBoolProperty(nodeName,\"%1\",boolean)");
   QCheckBox* cb = new QCheckBox;
-  cb->setToolTip(toolTip.arg(prop->objectName()));
+  cb->setToolTip(toolTip.arg(QString::fromStdString(prop->name())));
   bool value;
   /* bool success = */ prop->get(value);
   cb->setChecked(value);
   if (prop->hasWriteAccess()) {
-    prop->connect(cb, SIGNAL(toggled(bool)), SLOT(set(bool)),
-                  Qt::DirectConnection);
-    cb->connect(prop, SIGNAL(valueChanged(bool)), SLOT(setChecked(bool)),
+    PropertyNotifier* notifier = prop->notifier();
+    notifier->connect(cb, SIGNAL(toggled(bool)), SLOT(set(bool)),
+                      Qt::DirectConnection);
+    cb->connect(notifier, SIGNAL(valueChanged(bool)), SLOT(setChecked(bool)),
                 Qt::DirectConnection);
   } else
     cb->setEnabled(false);
@@ -214,15 +266,16 @@ QWidget* buildEditor<std::string>(Property* prop) {
       "  gui.getStringProperty(nodeName,\"%1\")\n"
       "  gui.setStringProperty(nodeName,\"%1\",str)");
   QLineEdit* le = new QLineEdit;
-  le->setToolTip(toolTip.arg(prop->objectName()));
+  le->setToolTip(toolTip.arg(QString::fromStdString(prop->name())));
   std::string value;
   /* bool success = */ prop->get(value);
   le->setText(QString::fromStdString(value));
   if (prop->hasWriteAccess()) {
-    prop->connect(le, SIGNAL(textChanged(QString)), SLOT(set(QString)),
-                  Qt::DirectConnection);
-    le->connect(prop, SIGNAL(valueChanged(QString)), SLOT(setText(QString)),
-                Qt::DirectConnection);
+    PropertyNotifier* notifier = prop->notifier();
+    notifier->connect(le, SIGNAL(textChanged(QString)), SLOT(set(QString)),
+                      Qt::DirectConnection);
+    le->connect(notifier, SIGNAL(valueChanged(QString)),
+                SLOT(setText(QString)), Qt::DirectConnection);
   } else
     le->setReadOnly(true);
   return le;
@@ -235,16 +288,17 @@ QWidget* buildEditor<float>(Property* prop) {
       "  gui.getFloatProperty(nodeName,\"%1\")\n"
       "  gui.setFloatProperty(nodeName,\"%1\",float)");
   QDoubleSpinBox* dsb = new QDoubleSpinBox;
-  dsb->setObjectName(prop->objectName());
-  dsb->setToolTip(toolTip.arg(prop->objectName()));
+  dsb->setObjectName(QString::fromStdString(prop->name()));
+  dsb->setToolTip(toolTip.arg(QString::fromStdString(prop->name())));
   float value;
   /* bool success = */ prop->get(value);
   dsb->setValue(value);
   if (prop->hasWriteAccess()) {
-    prop->connect(dsb, SIGNAL(valueChanged(double)), SLOT(set(double)),
-                  Qt::DirectConnection);
-    dsb->connect(prop, SIGNAL(valueChanged(double)), SLOT(setValue(double)),
-                 Qt::DirectConnection);
+    PropertyNotifier* notifier = prop->notifier();
+    notifier->connect(dsb, SIGNAL(valueChanged(double)), SLOT(set(double)),
+                      Qt::DirectConnection);
+    dsb->connect(notifier, SIGNAL(valueChanged(double)),
+                 SLOT(setValue(double)), Qt::DirectConnection);
   } else
     dsb->setEnabled(false);
   setSpinBoxRange<float, double>(prop, dsb);
@@ -259,14 +313,15 @@ QWidget* buildEditor<int>(Property* prop) {
       "  gui.getIntProperty(nodeName,\"%1\")\n"
       "  gui.setIntProperty(nodeName,\"%1\",int)");
   QSpinBox* dsb = new QSpinBox;
-  dsb->setToolTip(toolTip.arg(prop->objectName()));
+  dsb->setToolTip(toolTip.arg(QString::fromStdString(prop->name())));
   int value;
   /* bool success = */ prop->get(value);
   dsb->setValue(value);
   if (prop->hasWriteAccess()) {
-    prop->connect(dsb, SIGNAL(valueChanged(int)), SLOT(set(int)),
-                  Qt::DirectConnection);
-    dsb->connect(prop, SIGNAL(valueChanged(int)), SLOT(setValue(int)),
+    PropertyNotifier* notifier = prop->notifier();
+    notifier->connect(dsb, SIGNAL(valueChanged(int)), SLOT(set(int)),
+                      Qt::DirectConnection);
+    dsb->connect(notifier, SIGNAL(valueChanged(int)), SLOT(setValue(int)),
                  Qt::DirectConnection);
   } else
     dsb->setEnabled(false);
@@ -302,23 +357,24 @@ QWidget* buildVectorNEditor(const QString& name, int N, Property* prop) {
   /// Vector3 dialog should be opened in a different place
   Dialog_t* cfgDialog = new Dialog_t(prop);
   cfgDialog->setValueFromProperty(prop);
+  PropertyNotifier* notifier = prop->notifier();
   switch (N) {
     case 2:
-      prop->connect(cfgDialog, SIGNAL(valueChanged(osgVector2)),
-                    SLOT(set(osgVector2)), Qt::DirectConnection);
-      cfgDialog->connect(prop, SIGNAL(valueChanged(osgVector2)),
+      notifier->connect(cfgDialog, SIGNAL(valueChanged(osgVector2)),
+                        SLOT(set(osgVector2)), Qt::DirectConnection);
+      cfgDialog->connect(notifier, SIGNAL(valueChanged(osgVector2)),
                          SLOT(set(osgVector2)), Qt::DirectConnection);
       break;
     case 3:
-      prop->connect(cfgDialog, SIGNAL(valueChanged(osgVector3)),
-                    SLOT(set(osgVector3)), Qt::DirectConnection);
-      cfgDialog->connect(prop, SIGNAL(valueChanged(osgVector3)),
+      notifier->connect(cfgDialog, SIGNAL(valueChanged(osgVector3)),
+                        SLOT(set(osgVector3)), Qt::DirectConnection);
+      cfgDialog->connect(notifier, SIGNAL(valueChanged(osgVector3)),
                          SLOT(set(osgVector3)), Qt::DirectConnection);
       break;
     case 4:
-      prop->connect(cfgDialog, SIGNAL(valueChanged(osgVector4)),
-                    SLOT(set(osgVector4)), Qt::DirectConnection);
-      cfgDialog->connect(prop, SIGNAL(valueChanged(osgVector4)),
+      notifier->connect(cfgDialog, SIGNAL(valueChanged(osgVector4)),
+                        SLOT(set(osgVector4)), Qt::DirectConnection);
+      cfgDialog->connect(notifier, SIGNAL(valueChanged(osgVector4)),
                          SLOT(set(osgVector4)), Qt::DirectConnection);
       break;
     default:
@@ -333,13 +389,15 @@ QWidget* buildVectorNEditor(const QString& name, int N, Property* prop) {
 template <>
 QWidget* buildEditor<osgVector2>(Property* prop) {
   if (!prop->hasWriteAccess()) return NULL;
-  return buildVectorNEditor<osgVector2>(prop->objectName(), 2, prop);
+  return buildVectorNEditor<osgVector2>(QString::fromStdString(prop->name()),
+                                        2, prop);
 }
 
 template <>
 QWidget* buildEditor<osgVector3>(Property* prop) {
   if (!prop->hasWriteAccess()) return NULL;
-  return buildVectorNEditor<osgVector3>(prop->objectName(), 3, prop);
+  return buildVectorNEditor<osgVector3>(QString::fromStdString(prop->name()),
+                                        3, prop);
 }
 
 QWidget* buildColorEditor(QString& name, Property* prop) {
@@ -362,13 +420,15 @@ QWidget* buildColorEditor(QString& name, Property* prop) {
   colorDialog->setProperty("propertyName", name);
   colorDialog->connect(button, SIGNAL(clicked()), SLOT(open()));
 
-  prop->connect(colorDialog, SIGNAL(currentColorChanged(QColor)),
-                SLOT(set(QColor)), Qt::DirectConnection);
+  PropertyNotifier* notifier = prop->notifier();
+  notifier->connect(colorDialog, SIGNAL(currentColorChanged(QColor)),
+                    SLOT(set(QColor)), Qt::DirectConnection);
 #if __cplusplus >= 201103L and (QT_VERSION >= QT_VERSION_CHECK(5, 7, 0))
-  QObject::connect(prop, QOverload<const QColor&>::of(&Property::valueChanged),
-                   colorDialog, &QColorDialog::setCurrentColor,
-                   // SLOT(set(QColor)),
-                   Qt::DirectConnection);
+  QObject::connect(
+      notifier, QOverload<const QColor&>::of(&PropertyNotifier::valueChanged),
+      colorDialog, &QColorDialog::setCurrentColor,
+      // SLOT(set(QColor)),
+      Qt::DirectConnection);
 #endif
 
   return button;
@@ -378,11 +438,11 @@ template <>
 QWidget* buildEditor<osgVector4>(Property* prop) {
   if (!prop->hasWriteAccess()) return NULL;
 
-  QString name(prop->objectName());
+  QString name(QString::fromStdString(prop->name()));
   if (name.contains("color", Qt::CaseInsensitive))
     return buildColorEditor(name, prop);
 
-  return buildVectorNEditor<osgVector4>(prop->objectName(), 4, prop);
+  return buildVectorNEditor<osgVector4>(name, 4, prop);
 }
 
 template <>
@@ -397,9 +457,10 @@ QWidget* buildEditor<Configuration>(Property* prop) {
   /// Color dialog should be opened in a different place
   gui::ConfigurationDialog* cfgDialog = new gui::ConfigurationDialog(prop);
   cfgDialog->setValueFromProperty(prop);
-  prop->connect(cfgDialog, SIGNAL(valueChanged(Configuration)),
-                SLOT(set(Configuration)), Qt::DirectConnection);
-  cfgDialog->connect(prop, SIGNAL(valueChanged(Configuration)),
+  PropertyNotifier* notifier = prop->notifier();
+  notifier->connect(cfgDialog, SIGNAL(valueChanged(Configuration)),
+                    SLOT(set(Configuration)), Qt::DirectConnection);
+  cfgDialog->connect(notifier, SIGNAL(valueChanged(Configuration)),
                      SLOT(set(Configuration)), Qt::DirectConnection);
 
   cfgDialog->setProperty("propertyName", name);
@@ -546,11 +607,12 @@ QWidget* EnumProperty::guiEditor() {
     if (value == metaEnum_->names[i]) cb->setCurrentIndex(i);
   }
   if (hasWriteAccess()) {
-    connect(cb, SIGNAL(currentTextChanged(QString)), SLOT(set(QString)),
-            Qt::DirectConnection);
+    PropertyNotifier* notifier = this->notifier();
+    notifier->connect(cb, SIGNAL(currentTextChanged(QString)),
+                      SLOT(set(QString)), Qt::DirectConnection);
     // On Qt4, the combo box will not be updated.
 #if (QT_VERSION > QT_VERSION_CHECK(5, 0, 0))
-    cb->connect(this, SIGNAL(valueChanged(QString)),
+    cb->connect(notifier, SIGNAL(valueChanged(QString)),
                 SLOT(setCurrentText(QString)), Qt::DirectConnection);
 #endif
   } else
@@ -7,12 +7,20 @@
 //
 #include <gepetto/viewer/node-rod.h>
 
+#include <osg/Geometry>
 #include <sstream>
+#include <stdexcept>
 
 #include "log.hh"
 
 namespace gepetto {
 namespace viewer {
+namespace {
+/// Number of vertices around the tube.
+const unsigned int tubeSides = 12;
+/// Number of rings of each hemispherical end of the tube, the pole excluded.
+const unsigned int tubeCapRings = 3;
+}  // namespace
 
 // ---- protected constructor ---- //
 
@@ -23,6 +31,8 @@ NodeRod::NodeRod(const std::string& name, osgVector4 color, float radius,
   totalLength_ = totalLength;
   color_ = osgVector4(color);
   maxCapsule_ = maxCapsule;
+  lengths_.assign(maxCapsule, totalLength / ((float)maxCapsule));
+  poses_.assign(maxCapsule, Configuration(osgVector3(), osgQuat()));
 
   osgVector3 zero;
   // Z -> -X
@@ -36,6 +46,9 @@ NodeRod::NodeRod(const std::string& name, osgVector4 color, float radius,
     list_of_capsule_.push_back(cap);
     this->asQueue()->addChild(cap->asGroup());
   }
+
+  addProperty(BoolProperty::create("Tube", this, &NodeRod::getTube,
+                                   &NodeRod::setTube));
 }
 
 NodeRod::NodeRod(const NodeRod& other) : Node(other) {
@@ -44,6 +57,8 @@ NodeRod::NodeRod(const NodeRod& other) : Node(other) {
   totalLength_ = other.totalLength();
   color_ = other.color();
   maxCapsule_ = other.maxCapsule();
+  lengths_ = other.lengths_;
+  poses_ = other.poses_;
 
   for (i = 0; i < (size_t)other.maxCapsule(); i++) {
     LeafNodeCapsulePtr_t cap = LeafNodeCapsule::createCopy(other.getCapsule(i));
@@ -88,6 +103,14 @@ LeafNodeCapsulePtr_t NodeRod::getCapsule(size_t i) const {
   return list_of_capsule_.at(i);
 }
 
+void NodeRod::setColor(const osgVector4& color) {
+  color_ = color;
+  if (tube_colors_) {
+    (*tube_colors_)[0] = color;
+    tube_colors_->dirty();
+  }
+}
+
 /**
   Applyconfiguration to all the capsules of the rod,
   params is a sequence of maxCapsule parameter, size 8 (length + pos + quat), or
@@ -99,24 +122,180 @@ void NodeRod::applyConfiguration(std::vector<std::vector<value_type> > params) {
              "be the same as the number of capsules"
           << std::endl;
 
-  for (size_t i = 0; i < params.size(); i++) {
-    if (params.at(i).size() == 8) {
-      list_of_capsule_.at(i)->setHeight(params.at(i)[0]);
-      ::osg::Quat quat = ::osg::Quat(params.at(i)[5], params.at(i)[6],
-                                     params.at(i)[7], params.at(i)[4]);
-      ::osg::Vec3f pos =
-          ::osg::Vec3f(params.at(i)[1], params.at(i)[2], params.at(i)[3]);
-      list_of_capsule_.at(i)->applyConfiguration(pos, quat);
-    } else if (params.at(i).size() == 7) {
-      ::osg::Quat quat = ::osg::Quat(params.at(i)[4], params.at(i)[5],
-                                     params.at(i)[6], params.at(i)[3]);
-      ::osg::Vec3f pos =
-          ::osg::Vec3f(params.at(i)[0], params.at(i)[1], params.at(i)[2]);
-      list_of_capsule_.at(i)->applyConfiguration(pos, quat);
-
-    } else
+  for (size_t i = 0; i < params.size() && i < maxCapsule_; i++) {
+    const std::vector<value_type>& p = params[i];
+    if (p.size() == 8) {
+      lengths_[i] = p[0];
+      poses_[i] = Configuration(&p[1], false);
+    } else if (p.size() == 7)
+      poses_[i] = Configuration(&p[0], false);
+    else
       log() << "Parameter must have 7 or 8 elements" << std::endl;
   }
+  updateCapsules();
+}
+
+void NodeRod::applyConfiguration(const value_type* params, std::size_t size) {
+  bool withLength;
+  if (size == 8 * maxCapsule_)
+    withLength = true;
+  else if (size == 7 * maxCapsule_)
+    withLength = false;
+  else
+    throw std::invalid_argument(
+        "The number of values must be 7 or 8 times the number of capsules.");
+
+  for (size_t i = 0; i < maxCapsule_; i++) {
+    if (withLength) lengths_[i] = *params++;
+    poses_[i] = Configuration(params, false);
+    params += 7;
+  }
+  updateCapsules();
+}
+
+void NodeRod::updateCapsules() {
+  if (tube_ptr_) {
+    updateTube();
+    return;
+  }
+  for (size_t i = 0; i < maxCapsule_; i++) {
+    if (list_of_capsule_[i]->getHeight() != lengths_[i])
+      list_of_capsule_[i]->setHeight(lengths_[i]);
+    list_of_capsule_[i]->applyConfiguration(poses_[i].position,
+                                            poses_[i].quat);
+  }
+}
+
+void NodeRod::setTube(bool tube) {
+  if (tube == getTube() || maxCapsule_ == 0) return;
+  if (tube) {
+    for (size_t i = 0; i < maxCapsule_; i++)
+      asQueue()->removeChild(list_of_capsule_[i]->asGroup());
+    createTube();
+    asQueue()->addChild(tube_ptr_);
+    updateTube();
+  } else {
+    asQueue()->removeChild(tube_ptr_);
+    tube_ptr_ = NULL;
+    tube_vertices_ = NULL;
+    tube_normals_ = NULL;
+    tube_colors_ = NULL;
+    for (size_t i = 0; i < maxCapsule_; i++)
+      asQueue()->addChild(list_of_capsule_[i]->asGroup());
+    updateCapsules();
+  }
+}
+
+/* The tube is made of rings of tubeSides vertices, along the X axis of the
+ * capsules: tubeCapRings rings for the first end, one ring at the start of
+ * the first capsule, one ring between each pair of consecutive capsules,
+ * one ring at the end of the last capsule and tubeCapRings rings for the
+ * last end. The two poles come last. Only the vertices and normals change
+ * with the configuration. */
+void NodeRod::createTube() {
+  const unsigned int K = tubeSides;
+  const unsigned int rings = 2 * tubeCapRings + (unsigned int)maxCapsule_ + 1;
+  const unsigned int nVertices = rings * K + 2;
+  const unsigned int pole0 = rings * K, pole1 = pole0 + 1;
+
+  tube_vertices_ = new ::osg::Vec3Array(nVertices);
+  tube_normals_ = new ::osg::Vec3Array(nVertices);
+  tube_colors_ = new ::osg::Vec4Array(1);
+  (*tube_colors_)[0] = color_;
+
+  ::osg::ref_ptr< ::osg::DrawElementsUInt> triangles =
+      new ::osg::DrawElementsUInt(GL_TRIANGLES);
+  triangles->reserve(6 * K * rings);
+  for (unsigned int k = 0; k < K; ++k) {
+    unsigned int k1 = (k + 1) % K;
+    triangles->push_back(pole0);
+    triangles->push_back(k1);
+    triangles->push_back(k);
+    for (unsigned int r = 0; r + 1 < rings; ++r) {
+      unsigned int a = r * K, b = a + K;
+      triangles->push_back(a + k);
+      triangles->push_back(a + k1);
+      triangles->push_back(b + k);
+      triangles->push_back(a + k1);
+      triangles->push_back(b + k1);
+      triangles->push_back(b + k);
+    }
+    triangles->push_back(pole0 - K + k);
+    triangles->push_back(pole0 - K + k1);
+    triangles->push_back(pole1);
+  }
+
+  ::osg::GeometryRefPtr geom = new ::osg::Geometry;
+  geom->setName(getID() + "_tube");
+  geom->setDataVariance(::osg::Object::DYNAMIC);
+  geom->setUseDisplayList(false);
+  geom->setUseVertexBufferObjects(true);
+  geom->setVertexArray(tube_vertices_);
+  geom->setNormalArray(tube_normals_, ::osg::Array::BIND_PER_VERTEX);
+  geom->setColorArray(tube_colors_, ::osg::Array::BIND_OVERALL);
+  geom->addPrimitiveSet(triangles);
+
+  tube_ptr_ = new ::osg::Geode;
+  tube_ptr_->setName(getID() + "_tube");
+  tube_ptr_->addDrawable(geom);
+}
+
+/* Set the vertices of a ring centered on base, in the plane orthogonal to
+ * the X axis of quat, shifted by axis. phi is the angle between the ring
+ * and the equator of a sphere centered on base. */
+void NodeRod::setTubeRing(unsigned int ring, const osgVector3& base,
+                          const osgQuat& quat, const osgVector3& axis,
+                          float phi) {
+  const unsigned int K = tubeSides;
+  const float c = cosf(phi), s = sinf(phi);
+  for (unsigned int k = 0; k < K; ++k) {
+    const float theta = 2 * (float)M_PI * (float)k / (float)K;
+    osgVector3 normal =
+        quat * osgVector3(0, c * cosf(theta), c * sinf(theta)) + axis * s;
+    (*tube_vertices_)[ring * K + k] = base + normal * radius_;
+    (*tube_normals_)[ring * K + k] = normal;
+  }
+}
+
+void NodeRod::updateTube() {
+  const unsigned int K = tubeSides;
+  const unsigned int N = (unsigned int)maxCapsule_;
+  const unsigned int rings = 2 * tubeCapRings + N + 1;
+
+  // Ends of the capsules.
+  std::vector<osgVector3> starts(N), ends(N), axes(N);
+  for (unsigned int i = 0; i < N; ++i) {
+    axes[i] = poses_[i].quat * osgVector3(1, 0, 0);
+    starts[i] = poses_[i].position - axes[i] * (lengths_[i] / 2);
+    ends[i] = poses_[i].position + axes[i] * (lengths_[i] / 2);
+  }
+
+  for (unsigned int c = 0; c < tubeCapRings; ++c) {
+    float phi = (float)M_PI / 2 * (float)(tubeCapRings - c) /
+                (float)(tubeCapRings + 1);
+    setTubeRing(c, starts[0], poses_[0].quat, -axes[0], phi);
+    setTubeRing(rings - 1 - c, ends[N - 1], poses_[N - 1].quat, axes[N - 1],
+                phi);
+  }
+  setTubeRing(tubeCapRings, starts[0], poses_[0].quat, osgVector3(), 0);
+  for (unsigned int i = 0; i + 1 < N; ++i) {
+    osgQuat quat;
+    quat.slerp(0.5, poses_[i].quat, poses_[i + 1].quat);
+    setTubeRing(tubeCapRings + 1 + i, (ends[i] + starts[i + 1]) / 2, quat,
+                osgVector3(), 0);
+  }
+  setTubeRing(tubeCapRings + N, ends[N - 1], poses_[N - 1].quat, osgVector3(),
+              0);
+
+  (*tube_vertices_)[rings * K] = starts[0] - axes[0] * radius_;
+  (*tube_normals_)[rings * K] = -axes[0];
+  (*tube_vertices_)[rings * K + 1] = ends[N - 1] + axes[N - 1] * radius_;
+  (*tube_normals_)[rings * K + 1] = axes[N - 1];
+
+  tube_vertices_->dirty();
+  tube_normals_->dirty();
+  tube_ptr_->getDrawable(0)->dirtyBound();
+  tube_ptr_->dirtyBound();
 }
 
 } /* namespace viewer */
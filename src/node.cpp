@@ -252,6 +252,9 @@ void setFlag(::osg::Node* node, osg::Node::NodeMask bit, bool on) {
     node->setNodeMask(node->getNodeMask() & ~bit);
 }
 
+/// Number of highlight states, see Node::setupHighlightState.
+const unsigned int NbHighlightStates = 9;
+
 MetaEnum* highlightStateEnum() {
   static MetaEnum hs;
   if (hs.type.size() == 0) {
@@ -285,10 +288,10 @@ const float Node::TransparencyRenderingBinThreshold = 0.99f;
 /* Declaration of private function members */
 void Node::init() {
   /* Build local conformation
-     <- wireframe_node_ptr_
-     connected to the parent <- switch_node_ptr_                           <-
-     auto_transform_ptr_ <- connection of children here
-     <- normal_node_ptr_
+     connected to the parent <- switch_node_ptr_
+       <- (wireframe_node_ptr_) <- hl_switch_node_ptr_
+       <- (highlight_nodes_[state]) <- transform_ptr_
+       <- connection of children here
   */
   scale_.value = osgVector3(1, 1, 1);
   scale_.min = 0.f;
@@ -305,33 +308,17 @@ void Node::init() {
 
   switch_node_ptr_->setNodeMask(VisibilityBit | NodeBit | IntersectionBit);
   switch_node_ptr_->setName(id_name_);
-  wireframe_modes_.resize(2);
-  wireframe_modes_[FILL] = new ::osg::Group;
-  wireframe_modes_[FILL]->setName("wireframe: FILL");
-  wireframe_modes_[WIREFRAME] = new ::osg::Group;
-  wireframe_modes_[WIREFRAME]->setName("wireframe: WIREFRAME");
 
-  /* Building hierarchie */
+  /* Building hierarchie. The wireframe and highlight nodes are created when
+   * they are first used. */
   selected_wireframe_ = FILL;
-  switch_node_ptr_->addChild(wireframe_modes_[FILL]);
-  wireframe_modes_[FILL]->addChild(hl_switch_node_ptr_);
-  wireframe_modes_[FILL]->setDataVariance(osg::Object::STATIC);
+  switch_node_ptr_->addChild(hl_switch_node_ptr_);
 
-  // Setup highlight states
-  highlight_nodes_.resize(9);
   selected_highlight_ = 0;
   highlight_enabled_ = true;
-  highlight_nodes_[0] = transform_ptr_;
-  for (unsigned int i = 1; i < 9; ++i) {
-    highlight_nodes_[i] = setupHighlightState(i);
-    highlight_nodes_[i]->addChild(transform_ptr_);
-  }
-  // setHighlightState(0);
-  hl_switch_node_ptr_->addChild(highlight_nodes_[selected_highlight_]);
+  hl_switch_node_ptr_->addChild(transform_ptr_);
   hl_switch_node_ptr_->setName("highlight switch");
 
-  wireframe_modes_[WIREFRAME]->setStateSet(getWireframeStateSet());
-  wireframe_modes_[WIREFRAME]->setDataVariance(osg::Object::STATIC);
   geode_ptr_ = NULL;
   alpha_ = 1.;
 
@@ -494,12 +481,10 @@ void Node::setWireFrameMode(const WireFrameMode& mode) {
     case 0:
       break;
     case 1:
-      wireframe_modes_[FILL]->addChild(hl_switch_node_ptr_);
-      switch_node_ptr_->addChild(wireframe_modes_[FILL]);
+      switch_node_ptr_->addChild(hl_switch_node_ptr_);
       break;
     case 2:
-      wireframe_modes_[FILL]->removeChild(hl_switch_node_ptr_);
-      switch_node_ptr_->removeChild(wireframe_modes_[FILL]);
+      switch_node_ptr_->removeChild(hl_switch_node_ptr_);
       break;
     default:
       assert(false && "Wrong action");
@@ -508,12 +493,12 @@ void Node::setWireFrameMode(const WireFrameMode& mode) {
     case 0:
       break;
     case 1:
-      wireframe_modes_[WIREFRAME]->addChild(hl_switch_node_ptr_);
-      switch_node_ptr_->addChild(wireframe_modes_[WIREFRAME]);
+      getOrCreateWireframeNode()->addChild(hl_switch_node_ptr_);
+      switch_node_ptr_->addChild(wireframe_node_ptr_);
       break;
     case 2:
-      wireframe_modes_[WIREFRAME]->removeChild(hl_switch_node_ptr_);
-      switch_node_ptr_->removeChild(wireframe_modes_[WIREFRAME]);
+      wireframe_node_ptr_->removeChild(hl_switch_node_ptr_);
+      switch_node_ptr_->removeChild(wireframe_node_ptr_);
       break;
     default:
       assert(false && "Wrong action");
@@ -618,11 +603,35 @@ void Node::deleteLandmark() {
   return node;
 }
 
+const osg::GroupRefPtr& Node::getOrCreateHighlightNode(unsigned int state) {
+  if (highlight_nodes_.empty()) {
+    highlight_nodes_.resize(NbHighlightStates);
+    highlight_nodes_[0] = transform_ptr_;
+  }
+  if (!highlight_nodes_[state]) {
+    highlight_nodes_[state] = setupHighlightState(state);
+    highlight_nodes_[state]->addChild(transform_ptr_);
+  }
+  return highlight_nodes_[state];
+}
+
+const osg::GroupRefPtr& Node::getOrCreateWireframeNode() {
+  if (!wireframe_node_ptr_) {
+    wireframe_node_ptr_ = new ::osg::Group;
+    wireframe_node_ptr_->setName("wireframe: WIREFRAME");
+    wireframe_node_ptr_->setStateSet(getWireframeStateSet());
+    wireframe_node_ptr_->setDataVariance(osg::Object::STATIC);
+  }
+  return wireframe_node_ptr_;
+}
+
 void Node::setHighlightState(unsigned int state) {
   if (!highlight_enabled_) return;
-  if (state != selected_highlight_ && state < highlight_nodes_.size()) {
-    hl_switch_node_ptr_->replaceChild(highlight_nodes_[selected_highlight_],
-                                      highlight_nodes_[state]);
+  if (state != selected_highlight_ && state < NbHighlightStates) {
+    osg::GroupRefPtr current = getOrCreateHighlightNode(
+        static_cast<unsigned int>(selected_highlight_));
+    hl_switch_node_ptr_->replaceChild(current,
+                                      getOrCreateHighlightNode(state));
     // Update the child
     selected_highlight_ = state;
     dirty_ = true;
@@ -660,6 +669,31 @@ void Node::setTransparency(const float& transparency) {
 
 float Node::getTransparency() const { return 1.f - getAlpha(); }
 
+std::size_t Node::getOverheadBytes() const {
+  // Scene graph nodes
+  std::size_t bytes = 2 * sizeof(osg::Group) + sizeof(osg::MatrixTransform);
+  if (wireframe_node_ptr_) bytes += sizeof(osg::Group);
+  bytes += highlight_nodes_.capacity() * sizeof(osg::GroupRefPtr);
+  for (std::size_t i = 1; i < highlight_nodes_.size(); ++i) {
+    if (!highlight_nodes_[i]) continue;
+    if (dynamic_cast<osgFX::Effect*>(highlight_nodes_[i].get()))
+      bytes += sizeof(osgFX::Outline);
+    else
+      bytes += sizeof(osg::Group);
+  }
+  if (landmark_geode_ptr_) bytes += sizeof(osg::Geode) + sizeof(osg::Geometry);
+
+  // Properties: the map node and, when owned, the property itself.
+  for (PropertyMap_t::const_iterator _prop = properties_.begin();
+       _prop != properties_.end(); ++_prop) {
+    bytes += sizeof(PropertyMap_t::value_type) + 4 * sizeof(void*) +
+             _prop->first.capacity();
+    if (_prop->second.lock) bytes += sizeof(PropertyTpl<int>);
+    if (_prop->second->hasNotifier()) bytes += sizeof(PropertyNotifier);
+  }
+  return bytes;
+}
+
 void Node::setTransparentRenderingBin(bool transparent, osg::StateSet* ss) {
   if (ss == NULL) {
     if (geode_ptr_.get() == NULL) {
@@ -0,0 +1,125 @@
+//
+//  ray-caster.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/ray-caster.h>
+
+#include <gepetto/viewer/frozen-geometry.h>
+#include <gepetto/viewer/node.h>
+
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <osgUtil/IntersectionVisitor>
+#include <osgUtil/LineSegmentIntersector>
+#include <stdexcept>
+
+namespace gepetto {
+namespace viewer {
+namespace {
+/// Fewer rays are not worth starting a thread.
+const std::size_t minRaysPerThread = 64;
+
+/// Cast a range of rays.
+class RayCastThread : public OpenThreads::Thread {
+ public:
+  RayCastThread(osg::Node* root, const std::vector<osgVector3>& origins,
+                const std::vector<osgVector3>& directions, float maxDistance,
+                std::vector<RayHit>& hits, std::size_t begin, std::size_t end)
+      : root_(root),
+        origins_(origins),
+        directions_(directions),
+        maxDistance_(maxDistance),
+        hits_(hits),
+        begin_(begin),
+        end_(end) {}
+
+  virtual void run() {
+    for (std::size_t i = begin_; i < end_; ++i) cast(i);
+  }
+
+ private:
+  osg::Node* root_;
+  const std::vector<osgVector3>& origins_;
+  const std::vector<osgVector3>& directions_;
+  float maxDistance_;
+  std::vector<RayHit>& hits_;
+  std::size_t begin_, end_;
+
+  void cast(std::size_t i) {
+    osgVector3 direction(directions_[i]);
+    if (direction.normalize() == 0) return;
+    const osg::Vec3d start(origins_[i]),
+        end(origins_[i] + direction * maxDistance_);
+
+    osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector =
+        new osgUtil::LineSegmentIntersector(osgUtil::Intersector::MODEL,
+                                            start, end);
+    intersector->setIntersectionLimit(osgUtil::Intersector::LIMIT_NEAREST);
+    osgUtil::IntersectionVisitor iv(intersector);
+    iv.setTraversalMask(IntersectionBit);
+    root_->accept(iv);
+    if (!intersector->containsIntersections()) return;
+
+    const osgUtil::LineSegmentIntersector::Intersection& intersection =
+        intersector->getFirstIntersection();
+    RayHit& hit = hits_[i];
+    hit.point = intersection.getWorldIntersectPoint();
+    hit.normal = intersection.getWorldIntersectNormal();
+    hit.distance = (float)(osg::Vec3d(hit.point) - start).length();
+    // The merged geometries of a frozen group know the original nodes.
+    const FrozenGeometry* frozen =
+        dynamic_cast<const FrozenGeometry*>(intersection.drawable.get());
+    if (frozen) hit.node = frozen->nodeAtTriangle(intersection.primitiveIndex);
+    for (int j = (int)intersection.nodePath.size() - 1;
+         hit.node.empty() && j >= 0; --j)
+      if (intersection.nodePath[j]->getNodeMask() & NodeBit)
+        hit.node = intersection.nodePath[j]->getName();
+  }
+};
+}  // namespace
+
+RayCaster::RayCaster(unsigned int numThreads)
+    : numThreads_(numThreads), maxDistance_(1e3f) {
+  if (numThreads_ == 0)
+    numThreads_ =
+        (unsigned int)std::max(1, OpenThreads::GetNumberOfProcessors());
+}
+
+std::vector<RayHit> RayCaster::cast(
+    const NodePtr_t& node, const std::vector<osgVector3>& origins,
+    const std::vector<osgVector3>& directions) const {
+  if (origins.size() != directions.size())
+    throw std::invalid_argument(
+        "The number of origins and directions must be equal");
+  std::vector<RayHit> hits(origins.size());
+  if (origins.empty()) return hits;
+
+  osg::GroupRefPtr root = node->asGroup();
+  // The bounds are computed lazily, which must not happen in parallel.
+  root->getBound();
+
+  std::size_t numThreads = std::min<std::size_t>(
+      numThreads_, (origins.size() + minRaysPerThread - 1) / minRaysPerThread);
+  std::size_t chunk = (origins.size() + numThreads - 1) / numThreads;
+  std::vector<RayCastThread*> threads;
+  for (std::size_t begin = chunk; begin < origins.size(); begin += chunk) {
+    threads.push_back(new RayCastThread(
+        root.get(), origins, directions, maxDistance_, hits, begin,
+        std::min(begin + chunk, origins.size())));
+    threads.back()->start();
+  }
+  // The first rays are cast by the calling thread.
+  RayCastThread(root.get(), origins, directions, maxDistance_, hits, 0,
+                std::min(chunk, origins.size()))
+      .run();
+  for (std::size_t i = 0; i < threads.size(); ++i) {
+    threads[i]->join();
+    delete threads[i];
+  }
+  return hits;
+}
+} /* namespace viewer */
+} /* namespace gepetto */
@@ -0,0 +1,193 @@
+//
+//  texture-cache.cpp
+//  gepetto-viewer
+//
+//  Copyright (c) 2026 LAAS-CNRS. All rights reserved.
+//
+
+#include <gepetto/viewer/texture-cache.h>
+#include <sys/stat.h>
+
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <map>
+#include <osg/observer_ptr>
+#include <osgDB/ImageProcessor>
+#include <osgDB/ReadFile>
+#include <osgDB/Registry>
+#include <osgDB/WriteFile>
+
+#include "cache-file.hh"
+#include "log.hh"
+
+namespace gepetto {
+namespace viewer {
+namespace {
+typedef std::pair<std::string, TextureCache::Filtering> Key_t;
+// The textures are released when no node uses them anymore.
+typedef std::map<Key_t, osg::observer_ptr<osg::Texture2D> > Textures_t;
+
+Textures_t textures;
+TextureCache::Compression compression = TextureCache::NO_COMPRESSION;
+OpenThreads::Mutex mutex;
+
+/// Count the released textures, so that prune does not scan the cache when
+/// none was released.
+struct ReleaseCounter : osg::Observer {
+  OpenThreads::Atomic released;
+
+  virtual void objectDeleted(void*) { ++released; }
+};
+// Never destroyed, since textures may outlive the static objects.
+ReleaseCounter* releaseCounter = new ReleaseCounter;
+
+/// Whether file exists and is not older than source.
+bool upToDate(const std::string& file, const std::string& source) {
+  struct stat fileStat, sourceStat;
+  return stat(file.c_str(), &fileStat) == 0 &&
+         stat(source.c_str(), &sourceStat) == 0 &&
+         fileStat.st_mtime >= sourceStat.st_mtime;
+}
+
+osg::ref_ptr<osg::Image> readImage(const std::string& imagePath) {
+  static const std::string exts[2] = {".dds", ".ktx"};
+  for (int i = 0; i < 2; ++i) {
+    std::string precompiled = imagePath + exts[i];
+    if (upToDate(precompiled, imagePath)) {
+      osg::ref_ptr<osg::Image> image = osgDB::readImageFile(precompiled);
+      if (image) return image;
+    }
+  }
+  std::string cached = cacheFileName(imagePath, ".dds");
+  struct stat cachedStat;
+  if (!cached.empty() && stat(cached.c_str(), &cachedStat) == 0) {
+    osg::ref_ptr<osg::Image> image = osgDB::readImageFile(cached);
+    if (image) return image;
+  }
+  return osgDB::readImageFile(imagePath);
+}
+
+/// Generate the mipmaps of an image, compress it in DXT if requested, and
+/// save the result in the cache directory of the user so that the next
+/// loadings skip this step.
+/// \return false if no image processor plugin (e.g. nvtt) is available.
+bool precompile(osg::Image& image, const std::string& imagePath) {
+  osgDB::ImageProcessor* processor =
+      osgDB::Registry::instance()->getImageProcessor();
+  if (processor == NULL) return false;
+  if (compression == TextureCache::DXT_COMPRESSION)
+    processor->compress(image,
+                        image.isImageTranslucent()
+                            ? osg::Texture::USE_S3TC_DXT5_COMPRESSION
+                            : osg::Texture::USE_S3TC_DXT1_COMPRESSION,
+                        true, true, osgDB::ImageProcessor::USE_CPU,
+                        osgDB::ImageProcessor::NORMAL);
+  else
+    // ETC compression is left to the driver.
+    processor->generateMipMap(image, true, osgDB::ImageProcessor::USE_CPU);
+
+  std::string precompiled = cacheFileName(imagePath, ".dds");
+  if (!precompiled.empty() && !osgDB::writeImageFile(image, precompiled))
+    logCacheWriteFailure(precompiled);
+  return true;
+}
+
+void setupCompression(osg::Texture2D* texture, const osg::Image* image) {
+  if (image->isCompressed()) return;
+  switch (compression) {
+    case TextureCache::DXT_COMPRESSION:
+      texture->setInternalFormatMode(
+          image->isImageTranslucent()
+              ? osg::Texture::USE_S3TC_DXT5_COMPRESSION
+              : osg::Texture::USE_S3TC_DXT1_COMPRESSION);
+      break;
+    case TextureCache::ETC_COMPRESSION:
+      // ETC1 has no alpha channel.
+      if (!image->isImageTranslucent())
+        texture->setInternalFormatMode(osg::Texture::USE_ETC_COMPRESSION);
+      break;
+    case TextureCache::NO_COMPRESSION:
+      break;
+  }
+}
+}  // namespace
+
+osg::ref_ptr<osg::Texture2D> TextureCache::get(const std::string& imagePath,
+                                               Filtering filtering) {
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  Key_t key(imagePath, filtering);
+  osg::ref_ptr<osg::Texture2D> texture;
+  Textures_t::iterator it = textures.find(key);
+  if (it != textures.end()) {
+    if (it->second.lock(texture)) return texture;
+    textures.erase(it);
+  }
+
+  osg::ref_ptr<osg::Image> image = readImage(imagePath);
+  if (!image) return osg::ref_ptr<osg::Texture2D>();
+  if (filtering == MIPMAP_FILTERING && !image->isMipmap() &&
+      !image->isCompressed() && !precompile(*image, imagePath))
+    log() << "No image processor to precompile " << imagePath << std::endl;
+
+  texture = new osg::Texture2D;
+  texture->setDataVariance(osg::Object::STATIC);
+  switch (filtering) {
+    case MIPMAP_FILTERING:
+      texture->setFilter(osg::Texture::MIN_FILTER,
+                         osg::Texture::LINEAR_MIPMAP_LINEAR);
+      texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+      texture->setUseHardwareMipMapGeneration(true);
+      break;
+    case NEAREST_FILTERING:
+      // Do not resize image to closest power of two values for width and
+      // height
+      texture->setResizeNonPowerOfTwoHint(false);
+      // Disable interpolation between pixels.
+      texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+      break;
+  }
+  setupCompression(texture, image);
+  texture->setImage(image);
+  texture->addObserver(releaseCounter);
+
+  textures[key] = texture;
+  return texture;
+}
+
+void TextureCache::setCompression(Compression c) {
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  compression = c;
+}
+
+TextureCache::Compression TextureCache::getCompression() {
+  return compression;
+}
+
+bool TextureCache::setCompression(const std::string& c) {
+  if (c == "none")
+    setCompression(NO_COMPRESSION);
+  else if (c == "dxt")
+    setCompression(DXT_COMPRESSION);
+  else if (c == "etc")
+    setCompression(ETC_COMPRESSION);
+  else {
+    log() << "Unknown texture compression " << c << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void TextureCache::prune() {
+  if (releaseCounter->released.exchange(0) == 0) return;
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mutex);
+  Textures_t::iterator it = textures.begin();
+  while (it != textures.end()) {
+    if (!it->second.valid())
+      textures.erase(it++);
+    else
+      ++it;
+  }
+}
+} /* namespace viewer */
+} /* namespace gepetto */
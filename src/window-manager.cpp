@@ -7,13 +7,26 @@
 //
 
 #include <gepetto/viewer/OSGManipulator/keyboard-manipulator.h>
+#include <gepetto/viewer/leaf-node-collada.h>
+#include <gepetto/viewer/node-visitor.h>
 #include <gepetto/viewer/window-manager.h>
 
 #include <osg/Camera>
 #include <osg/DisplaySettings>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/observer_ptr>
+#include <osg/Program>
+#include <osg/Stats>
+#include <osg/Version>
 #include <osgDB/WriteFile>
 #include <osgGA/NodeTrackerManipulator>
 #include <osgGA/TrackballManipulator>
+#include <osgUtil/CullVisitor>
+#include <osgUtil/LineSegmentIntersector>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 #include "internal/configuration.hh"
@@ -123,6 +136,178 @@ struct WriteToFile : osgViewer::ScreenCaptureHandler::CaptureOperation {
   const std::string ext;
   unsigned int counter;
 };
+
+/// Meshes with less vertices do not benefit from occlusion queries.
+const std::size_t occlusionQueryMinVertices = 5000;
+
+MetaEnum* computeNearFarModeEnum() {
+  static MetaEnum nf;
+  if (nf.type.size() == 0) {
+    nf.type = "ComputeNearFarMode";
+    nf.names.push_back("DO_NOT_COMPUTE");
+    nf.values.push_back(osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR);
+    nf.names.push_back("BOUNDING_VOLUMES");
+    nf.values.push_back(
+        osg::CullSettings::COMPUTE_NEAR_FAR_USING_BOUNDING_VOLUMES);
+    nf.names.push_back("PRIMITIVES");
+    nf.values.push_back(osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES);
+  }
+  return &nf;
+}
+
+/// Count the vertices of a mesh.
+struct CountVertices : osg::NodeVisitor {
+  std::size_t n;
+
+  CountVertices() : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN), n(0) {}
+
+  void apply(osg::Geode& geode) {
+    for (unsigned int i = 0; i < geode.getNumDrawables(); ++i)
+      count(geode.getDrawable(i));
+  }
+
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 3, 2)
+  void apply(osg::Drawable& drawable) { count(&drawable); }
+#endif
+
+  void count(const osg::Drawable* drawable) {
+    const osg::Geometry* geom = drawable->asGeometry();
+    if (geom != NULL && geom->getVertexArray() != NULL)
+      n += geom->getVertexArray()->getNumElements();
+  }
+};
+
+/// Count the drawables which are drawn when no culling is done.
+struct CountDrawables : osg::NodeVisitor {
+  std::size_t n;
+
+  CountDrawables(osg::Node::NodeMask mask)
+      : osg::NodeVisitor(TRAVERSE_ACTIVE_CHILDREN), n(0) {
+    setTraversalMask(mask);
+  }
+
+  void apply(osg::Geode& geode) { n += geode.getNumDrawables(); }
+
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 3, 2)
+  void apply(osg::Drawable&) { ++n; }
+#endif
+};
+
+/// The id buffer has a resolution divided by this factor.
+const int idBufferReduction = 2;
+const char* idUniformName = "gv_nodeId";
+/// Id written by the instanced meshes, whose nodes are found by ray picking.
+const std::size_t instancedMeshId = 0xFFFFFF;
+
+const char* idVertexShader =
+    "void main() {\n"
+    "  gl_Position = ftransform();\n"
+    "}\n";
+
+const char* idFragmentShader =
+    "uniform vec4 gv_nodeId;\n"
+    "void main() {\n"
+    "  gl_FragColor = gv_nodeId;\n"
+    "}\n";
+
+/// Encode an id in the red, green and blue bytes of a color.
+osg::Vec4 idToColor(std::size_t id) {
+  return osg::Vec4((float)(id & 0xFF), (float)((id >> 8) & 0xFF),
+                   (float)((id >> 16) & 0xFF), 255.f) /
+         255.f;
+}
+
+/// Give the id of a node to the id camera of a window. The state set holding
+/// the id is pushed during the cull traversal of this camera only, so that
+/// the rendering of the node is not modified.
+class IdCullCallback : public osg::NodeCallback {
+ public:
+  IdCullCallback(osg::Camera* camera)
+      : camera_(camera),
+        stateSet_(new osg::StateSet),
+        uniform_(new osg::Uniform(idUniformName, idToColor(0))),
+        id_(0) {
+    uniform_->setDataVariance(osg::Object::DYNAMIC);
+    stateSet_->setDataVariance(osg::Object::DYNAMIC);
+    stateSet_->addUniform(uniform_);
+  }
+
+  const osg::Camera* camera() const { return camera_.get(); }
+
+  std::size_t id() const { return id_; }
+
+  void setId(std::size_t id) {
+    if (id == id_) return;
+    id_ = id;
+    uniform_->set(idToColor(id));
+  }
+
+  virtual void operator()(osg::Node* node, osg::NodeVisitor* nv) {
+    osgUtil::CullVisitor* cv = dynamic_cast<osgUtil::CullVisitor*>(nv);
+    if (cv == NULL || cv->getCurrentCamera() != camera_.get()) {
+      traverse(node, nv);
+      return;
+    }
+    cv->pushStateSet(stateSet_.get());
+    traverse(node, nv);
+    cv->popStateSet();
+  }
+
+ private:
+  osg::observer_ptr<osg::Camera> camera_;
+  osg::ref_ptr<osg::StateSet> stateSet_;
+  osg::ref_ptr<osg::Uniform> uniform_;
+  std::size_t id_;
+};
+
+/// The callback of a node for an id camera, if any.
+/// The type of the callbacks depends on the version of OpenSceneGraph.
+template <typename Callback>
+IdCullCallback* findIdCullCallback(Callback* callback,
+                                   const osg::Camera* camera) {
+  for (; callback != NULL; callback = callback->getNestedCallback()) {
+    IdCullCallback* idCallback = dynamic_cast<IdCullCallback*>(callback);
+    if (idCallback != NULL && idCallback->camera() == camera)
+      return idCallback;
+  }
+  return NULL;
+}
+
+/// Number the nodes below a group. The id given to the root of each node
+/// is used by the nodes below it which are not numbered.
+void numberNodes(const GroupNode& group, osg::Camera* camera,
+                 std::vector<NodeWeakPtr>& nodes) {
+  for (std::size_t i = 0; i < group.getNumOfChildren(); ++i) {
+    NodePtr_t child = group.getChild(i);
+    if (!child || nodes.size() + 1 >= instancedMeshId) continue;
+    nodes.push_back(child);
+    osg::Group* root = child->asGroup();
+    IdCullCallback* callback =
+        findIdCullCallback(root->getCullCallback(), camera);
+    if (callback == NULL) {
+      callback = new IdCullCallback(camera);
+      root->addCullCallback(callback);
+    }
+    callback->setId(nodes.size());
+    GroupNodePtr_t childGroup = dynamic_pointer_cast<GroupNode>(child);
+    if (childGroup) numberNodes(*childGroup, camera, nodes);
+  }
+}
+
+struct SetOcclusionQueries : NodeVisitor {
+  bool enable;
+
+  SetOcclusionQueries(bool e) : NodeVisitor(true), enable(e) {}
+
+  void apply(LeafNodeCollada& leaf) {
+    if (enable) {
+      CountVertices count;
+      leaf.getColladaPtr()->accept(count);
+      if (count.n < occlusionQueryMinVertices) return;
+    }
+    leaf.setOcclusionQuery(enable);
+  }
+};
 }  // namespace
 
 void WindowManager::createManipulator() {
@@ -374,6 +559,237 @@ void WindowManager::setText(TextAlignment vPos, TextAlignment hPos,
   setDirty();
 }
 
+void WindowManager::createCullingProperties() {
+  RangedFloatProperty::Ptr_t smallFeature = RangedFloatProperty::create(
+      "Camera/SmallFeatureCulling", this,
+      &WindowManager::getSmallFeatureCullingPixelSize,
+      &WindowManager::setSmallFeatureCullingPixelSize);
+  smallFeature->setRange(0.f, 50.f, 1.f);
+  addProperty(smallFeature);
+
+  addProperty(EnumProperty::create(
+      "Camera/ComputeNearFar", computeNearFarModeEnum(),
+      [this]() -> int { return (int)main_camera_->getComputeNearFarMode(); },
+      [this](const int& mode) {
+        main_camera_->setComputeNearFarMode(
+            (osg::CullSettings::ComputeNearFarMode)mode);
+        lastSceneWasDisrty_ = true;
+      }));
+
+  addProperty(BoolProperty::create("Camera/OcclusionQueries", this,
+                                   &WindowManager::getOcclusionQueries,
+                                   &WindowManager::setOcclusionQueries));
+  addProperty(BoolProperty::create("IdPicking", this,
+                                   &WindowManager::getIdPicking,
+                                   &WindowManager::setIdPicking));
+}
+
+void WindowManager::setSmallFeatureCullingPixelSize(const float& pixels) {
+  osg::CullSettings::CullingMode mode = main_camera_->getCullingMode();
+  if (pixels > 0) {
+    mode |= osg::CullSettings::SMALL_FEATURE_CULLING;
+    main_camera_->setSmallFeatureCullingPixelSize(pixels);
+  } else
+    mode &= ~osg::CullSettings::SMALL_FEATURE_CULLING;
+  main_camera_->setCullingMode(mode);
+  lastSceneWasDisrty_ = true;
+}
+
+float WindowManager::getSmallFeatureCullingPixelSize() const {
+  if (!(main_camera_->getCullingMode() &
+        osg::CullSettings::SMALL_FEATURE_CULLING))
+    return 0.f;
+  return main_camera_->getSmallFeatureCullingPixelSize();
+}
+
+void WindowManager::setOcclusionQueries(const bool& enable) {
+  occlusionQueries_ = enable;
+  SetOcclusionQueries visitor(enable);
+  accept(visitor);
+  lastSceneWasDisrty_ = true;
+}
+
+void WindowManager::createIdCamera() {
+  id_image_ = new osg::Image;
+
+  // The view and the projection are those of the main camera.
+  id_camera_ = new osg::Camera;
+  id_camera_->setName("id_camera");
+  id_camera_->setReferenceFrame(osg::Transform::RELATIVE_RF);
+  id_camera_->setNodeMask(VisibilityBit);
+  id_camera_->setCullMask(VisibilityBit);
+  id_camera_->setRenderOrder(osg::Camera::PRE_RENDER);
+  id_camera_->setRenderTargetImplementation(
+      osg::Camera::FRAME_BUFFER_OBJECT);
+  id_camera_->setClearMask(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  // Id 0 means no node.
+  id_camera_->setClearColor(osg::Vec4(0.f, 0.f, 0.f, 0.f));
+  id_camera_->setAllowEventFocus(false);
+  id_camera_->addChild(asQueue());
+
+  osg::ref_ptr<osg::Program> program = new osg::Program;
+  program->setName("gv_nodeId");
+  program->addShader(new osg::Shader(osg::Shader::VERTEX, idVertexShader));
+  program->addShader(
+      new osg::Shader(osg::Shader::FRAGMENT, idFragmentShader));
+  osg::StateSet* ss = id_camera_->getOrCreateStateSet();
+  const int forced = osg::StateAttribute::OVERRIDE |
+                     osg::StateAttribute::PROTECTED;
+  ss->setAttributeAndModes(program, osg::StateAttribute::ON | forced);
+  ss->setMode(GL_BLEND, osg::StateAttribute::OFF | forced);
+  ss->setTextureMode(0, GL_TEXTURE_2D, osg::StateAttribute::OFF | forced);
+  ss->addUniform(new osg::Uniform(idUniformName, idToColor(0)));
+  // The instanced drawables protect their program, which draws the ids when
+  // this uniform is set.
+  ss->addUniform(new osg::Uniform("gv_idPass", true),
+                 osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+}
+
+void WindowManager::updateIdBuffer(bool sceneChanged) {
+  const osg::Viewport* vp = main_camera_->getViewport();
+  int width = std::max(1, (int)vp->width() / idBufferReduction),
+      height = std::max(1, (int)vp->height() / idBufferReduction);
+  if (id_image_->s() != width || id_image_->t() != height) {
+    id_image_->allocateImage(width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+    std::memset(id_image_->data(), 0, id_image_->getTotalSizeInBytes());
+    id_camera_->setViewport(0, 0, width, height);
+    // Recreate the frame buffer object with the new size.
+    id_camera_->detach(osg::Camera::COLOR_BUFFER);
+    id_camera_->detach(osg::Camera::DEPTH_BUFFER);
+    id_camera_->attach(osg::Camera::COLOR_BUFFER, id_image_.get());
+    id_camera_->attach(osg::Camera::DEPTH_BUFFER, GL_DEPTH_COMPONENT24);
+    id_camera_->setRenderingCache(NULL);
+    sceneChanged = true;
+  }
+  if (sceneChanged) {
+    id_nodes_.clear();
+    numberNodes(*this, id_camera_.get(), id_nodes_);
+  }
+  // The id camera is rendered only when the camera or the scene changed.
+  // Otherwise, it is masked out and the image keeps the last ids.
+  const osg::Matrix& view = main_camera_->getViewMatrix();
+  const osg::Matrix& projection = main_camera_->getProjectionMatrix();
+  bool changed =
+      sceneChanged || view != id_view_ || projection != id_projection_;
+  id_view_ = view;
+  id_projection_ = projection;
+  id_camera_->setNodeMask(changed ? VisibilityBit : 0x0);
+}
+
+void WindowManager::removeIdCullCallbacks() {
+  for (std::size_t i = 0; i < id_nodes_.size(); ++i) {
+    NodePtr_t node = id_nodes_[i].lock();
+    if (!node) continue;
+    osg::Group* root = node->asGroup();
+    IdCullCallback* callback =
+        findIdCullCallback(root->getCullCallback(), id_camera_.get());
+    if (callback != NULL) root->removeCullCallback(callback);
+  }
+  id_nodes_.clear();
+}
+
+void WindowManager::setIdPicking(const bool& enable) {
+  if (enable == getIdPicking()) return;
+  if (enable) {
+    createIdCamera();
+    asGroup()->addChild(id_camera_);
+  } else {
+    asGroup()->removeChild(id_camera_);
+    removeIdCullCallbacks();
+    id_camera_ = NULL;
+    id_image_ = NULL;
+  }
+  lastSceneWasDisrty_ = true;
+}
+
+NodePtr_t WindowManager::getNodeAt(const float& x, const float& y) const {
+  if (!id_camera_) return NodePtr_t();
+  const osg::Viewport* vp = main_camera_->getViewport();
+  int i = (int)((x - (float)vp->x()) / (float)idBufferReduction),
+      j = (int)((y - (float)vp->y()) / (float)idBufferReduction);
+  if (i < 0 || j < 0 || i >= id_image_->s() || j >= id_image_->t())
+    return NodePtr_t();
+  const unsigned char* color = id_image_->data(i, j);
+  std::size_t id = color[0] | (color[1] << 8) | (color[2] << 16);
+  if (id == instancedMeshId) return getNodeIntersectedAt(x, y);
+  if (id == 0 || id > id_nodes_.size()) return NodePtr_t();
+  return id_nodes_[id - 1].lock();
+}
+
+NodePtr_t WindowManager::getNodeIntersectedAt(const float& x,
+                                              const float& y) const {
+  osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector =
+      new osgUtil::LineSegmentIntersector(osgUtil::Intersector::WINDOW, x, y);
+  intersector->setIntersectionLimit(osgUtil::Intersector::LIMIT_NEAREST);
+  osgUtil::IntersectionVisitor iv(intersector);
+  iv.setTraversalMask(IntersectionBit);
+  main_camera_->accept(iv);
+  if (!intersector->containsIntersections()) return NodePtr_t();
+  // The closest numbered node of the path.
+  const osg::NodePath& path = intersector->getFirstIntersection().nodePath;
+  for (int i = (int)path.size() - 1; i >= 0; --i) {
+    IdCullCallback* callback =
+        findIdCullCallback(path[i]->getCullCallback(), id_camera_.get());
+    if (callback == NULL) continue;
+    std::size_t id = callback->id();
+    if (id == 0 || id > id_nodes_.size()) return NodePtr_t();
+    return id_nodes_[id - 1].lock();
+  }
+  return NodePtr_t();
+}
+
+void WindowManager::addCameraSensor(const CameraSensorPtr_t& sensor) {
+  if (!sensors_.insert(std::make_pair(sensor->getName(), sensor)).second)
+    throw std::invalid_argument("Window " + getID() +
+                                " already has a sensor " + sensor->getName());
+  asGroup()->addChild(sensor->setScene(asQueue()));
+}
+
+void WindowManager::removeCameraSensor(const std::string& name) {
+  std::map<std::string, CameraSensorPtr_t>::iterator it = sensors_.find(name);
+  if (it == sensors_.end())
+    throw std::invalid_argument("Window " + getID() + " has no sensor " +
+                                name);
+  asGroup()->removeChild(it->second->root_);
+  sensors_.erase(it);
+}
+
+CameraSensorPtr_t WindowManager::getCameraSensor(
+    const std::string& name) const {
+  std::map<std::string, CameraSensorPtr_t>::const_iterator it =
+      sensors_.find(name);
+  if (it == sensors_.end()) return CameraSensorPtr_t();
+  return it->second;
+}
+
+CullingStatistics WindowManager::getCullingStatistics() {
+  CullingStatistics statistics;
+  osg::Stats* stats = main_camera_->getStats();
+  if (stats == NULL) {
+    stats = new osg::Stats("Camera");
+    main_camera_->setStats(stats);
+  }
+  if (!stats->collectStats("scene")) {
+    stats->collectStats("scene", true);
+    lastSceneWasDisrty_ = true;
+    return statistics;
+  }
+
+  // The latest frame may still be in progress.
+  double drawn = 0;
+  unsigned int frame = stats->getLatestFrameNumber();
+  if (!stats->getAttribute(frame, "Visible number of drawables", drawn) &&
+      frame > 0)
+    stats->getAttribute(frame - 1, "Visible number of drawables", drawn);
+  statistics.drawn = (std::size_t)drawn;
+
+  CountDrawables count(main_camera_->getCullMask());
+  asGroup()->accept(count);
+  if (count.n > statistics.drawn)
+    statistics.culled = count.n - statistics.drawn;
+  return statistics;
+}
+
 void WindowManager::applyBackgroundColor() {
   osg::Vec4Array* colors = new osg::Vec4Array;
   colors->push_back(bg_color1_);
@@ -454,6 +870,8 @@ void WindowManager::init(osgViewer::Viewer* v, osg::GraphicsContext* gc) {
   viewer_ptr_ = v;
   viewer_ptr_->setSceneData(asGroup());
   lastSceneWasDisrty_ = true;
+  occlusionQueries_ = false;
+  id_camera_ = NULL;
 
   /* init main camera */
   main_camera_ = viewer_ptr_->getCamera();
@@ -476,6 +894,8 @@ void WindowManager::init(osgViewer::Viewer* v, osg::GraphicsContext* gc) {
       [this](const float& ratio) { main_camera_->setNearFarRatio(ratio); });
   prop->setRange(0., 1., 0.05f);
   addProperty(prop);
+
+  createCullingProperties();
 }
 
 WindowManager::WindowManager() : GroupNode(""), nodeTrackerManipulatorIndex(2) {
@@ -579,21 +999,33 @@ bool WindowManager::addNode(NodePtr_t graphical_object_ptr) {
 bool WindowManager::done() { return viewer_ptr_->done(); }
 
 bool WindowManager::frame() {
+  const osg::Timer_t tick = osg::Timer::instance()->tick();
+  bool sensorDue = false;
+  for (std::map<std::string, CameraSensorPtr_t>::const_iterator it =
+           sensors_.begin();
+       it != sensors_.end(); ++it)
+    if (it->second->prepareFrame(tick)) sensorDue = true;
+
   bool callFrame = screen_capture_ptr_;
+  bool sceneChanged = true;
   if (!callFrame) {
     IsDirtyVisitor isDirtyVisitor;
     accept(isDirtyVisitor);
     // FIXME For some reasons, when highlight state of a node is changed,
     // method frame must be called twice to get it rendered properly.
     // lastSceneWasDisrty_ forces to draw twice after a dirty scene.
-    callFrame = lastSceneWasDisrty_ || isDirtyVisitor.isDirty() ||
-                viewer_ptr_->checkNeedToDoFrame();
+    callFrame = sensorDue || lastSceneWasDisrty_ ||
+                isDirtyVisitor.isDirty() || viewer_ptr_->checkNeedToDoFrame();
+    sceneChanged = lastSceneWasDisrty_ || isDirtyVisitor.isDirty();
     lastSceneWasDisrty_ = isDirtyVisitor.isDirty();
   }
-  if (callFrame)
-    viewer_ptr_->frame();
-  else
-    return false;
+  if (!callFrame) return false;
+  if (id_camera_) updateIdBuffer(sceneChanged);
+  viewer_ptr_->frame();
+  for (std::map<std::string, CameraSensorPtr_t>::const_iterator it =
+           sensors_.begin();
+       it != sensors_.end(); ++it)
+    it->second->frameDone();
 
   SetCleanVisitor setCleanVisitor;
   accept(setCleanVisitor);
@@ -632,6 +1064,8 @@ osgVector2 WindowManager::getWindowPosition() const {
 }
 
 WindowManager::~WindowManager() {
+  // The nodes may be shown in other windows.
+  if (id_camera_) removeIdCullCallbacks();
   stopCapture();
   viewer_ptr_ = NULL;
 }
@@ -29,12 +29,15 @@
 #include <gepetto/viewer/leaf-node-ground.h>
 #include <gepetto/viewer/leaf-node-light.h>
 #include <gepetto/viewer/leaf-node-line.h>
+#include <gepetto/viewer/leaf-node-marker-array.h>
 #include <gepetto/viewer/leaf-node-sphere.h>
+#include <gepetto/viewer/leaf-node-tube.h>
 #include <gepetto/viewer/leaf-node-xyzaxis.h>
 #include <gepetto/viewer/macros.h>
 #include <gepetto/viewer/node-rod.h>
 #include <gepetto/viewer/node.h>
 #include <gepetto/viewer/roadmap-viewer.h>
+#include <gepetto/viewer/texture-cache.h>
 #include <gepetto/viewer/urdf-parser.h>
 #include <gepetto/viewer/window-manager.h>
 #include <sys/stat.h>
@@ -101,7 +104,33 @@ typedef std::map<std::string, GroupNodePtr_t>::iterator GroupNodeMapIt;
 typedef std::map<std::string, GroupNodePtr_t>::const_iterator
     GroupNodeMapConstIt;
 
+typedef std::map<std::string, std::set<std::string> >::iterator ParentMapIt;
+
+LeafNodeMarkerArray::Shape markerShape(const std::string& shape) {
+  if (shape == "SPHERE") return LeafNodeMarkerArray::SPHERE;
+  if (shape == "BOX") return LeafNodeMarkerArray::BOX;
+  if (shape == "CYLINDER") return LeafNodeMarkerArray::CYLINDER;
+  if (shape == "ARROW") return LeafNodeMarkerArray::ARROW;
+  throw std::invalid_argument("Unknown marker shape " + shape +
+                              ". Expected SPHERE, BOX, CYLINDER or ARROW.");
+}
+
 typedef ScopedLock ScopedLock;
+
+/// Destroy deleted nodes, so that deleteNodes does not wait for it.
+class ReleaseThread : public OpenThreads::Thread {
+ public:
+  /// Take the references of the caller, which does not destroy any node.
+  ReleaseThread(std::vector<NodePtr_t>& nodes) { nodes_.swap(nodes); }
+
+  virtual void run() {
+    nodes_.clear();
+    TextureCache::prune();
+  }
+
+ private:
+  std::vector<NodePtr_t> nodes_;
+};
 }  // namespace
 
 BlenderFrameCapture::BlenderFrameCapture()
@@ -120,12 +149,32 @@ WindowsManager::WindowsManager()
     : windowManagers_(),
       nodes_(),
       groupNodes_(),
+      parents_(),
       roadmapNodes_(),
       osgFrameMtx_(),
+      releaseThread_(NULL),
+      releaseMtx_(),
       configListMtx_(),
       newNodeConfigurations_(),
       autoCaptureTransform_(false) {}
 
+WindowsManager::~WindowsManager() {
+  ScopedLock lock(releaseMtx_);
+  if (releaseThread_ == NULL) return;
+  releaseThread_->join();
+  delete releaseThread_;
+}
+
+void WindowsManager::releaseNodes(std::vector<NodePtr_t>& nodes) {
+  ScopedLock lock(releaseMtx_);
+  if (releaseThread_ != NULL) {
+    releaseThread_->join();
+    delete releaseThread_;
+  }
+  releaseThread_ = new ReleaseThread(nodes);
+  releaseThread_->start();
+}
+
 WindowsManager::WindowID WindowsManager::addWindow(
     std::string winName, WindowManagerPtr_t newWindow) {
   WindowManagerMap_t::const_iterator it = windowManagers_.find(winName);
@@ -210,15 +259,17 @@ std::string WindowsManager::parentName(const std::string& name) {
 }
 
 NodePtr_t WindowsManager::find(const std::string name, GroupNodePtr_t) {
-  NodeMapIt it = nodes_.find(name);
-  if (it == nodes_.end()) {
-    std::string::size_type slash = name.find_first_of('/');
+  std::string::size_type begin = 0;
+  for (;;) {
+    NodeMapIt it = nodes_.find(name.substr(begin));
+    if (it != nodes_.end()) return it->second;
+    std::string::size_type slash = name.find_first_of('/', begin);
     if (slash == std::string::npos) return NodePtr_t();
-    GroupNodeMapIt itg = groupNodes_.find(name.substr(0, slash));
-    if (itg == groupNodes_.end()) return NodePtr_t();
-    return find(name.substr(slash + 1), itg->second);
+    if (groupNodes_.find(name.substr(begin, slash - begin)) ==
+        groupNodes_.end())
+      return NodePtr_t();
+    begin = slash + 1;
   }
-  return it->second;
 }
 
 bool WindowsManager::nodeExists(const std::string& name) {
@@ -256,7 +307,23 @@ std::size_t WindowsManager::getNodes(const Iterator& begin, const Iterator& end,
 }
 
 void WindowsManager::initParent(NodePtr_t node, GroupNodePtr_t parent) {
-  if (parent && !parent->hasChild(node)) parent->addChild(node);
+  if (!parent) return;
+  if (!parent->hasChild(node)) parent->addChild(node);
+  parents_[node->getID()].insert(parent->getID());
+}
+
+void WindowsManager::removeParent(const std::string& nodeName,
+                                  const std::string& groupName) {
+  ParentMapIt it = parents_.find(nodeName);
+  if (it == parents_.end()) return;
+  // The node may have been added several times to the group.
+  NodeMapConstIt node = nodes_.find(nodeName);
+  GroupNodeMapConstIt group = groupNodes_.find(groupName);
+  if (node != nodes_.end() && group != groupNodes_.end() &&
+      group->second->hasChild(node->second))
+    return;
+  it->second.erase(groupName);
+  if (it->second.empty()) parents_.erase(it);
 }
 
 void WindowsManager::addNode(const std::string& nodeName, NodePtr_t node,
@@ -329,6 +396,51 @@ bool WindowsManager::detachCamera(const WindowID windowId) {
   return true;
 }
 
+bool WindowsManager::addCameraSensor(const std::string& sensorName,
+                                     const WindowID windowId,
+                                     const std::string& nodeName,
+                                     const int width, const int height,
+                                     const float fovy, const float zNear,
+                                     const float zFar) {
+  NodePtr_t node = getNode(nodeName, true);
+  RETURN_FALSE_IF_WINDOW_DOES_NOT_EXIST(window, windowId);
+  if (width <= 0 || height <= 0)
+    throw std::invalid_argument("The sensor resolution must be positive");
+  CameraSensorPtr_t sensor =
+      CameraSensor::create(sensorName, node, (unsigned int)width,
+                           (unsigned int)height, fovy, zNear, zFar);
+  ScopedLock lock(osgFrameMutex());
+  window->addCameraSensor(sensor);
+  return true;
+}
+
+bool WindowsManager::removeCameraSensor(const std::string& sensorName,
+                                        const WindowID windowId) {
+  RETURN_FALSE_IF_WINDOW_DOES_NOT_EXIST(window, windowId);
+  ScopedLock lock(osgFrameMutex());
+  window->removeCameraSensor(sensorName);
+  return true;
+}
+
+bool WindowsManager::setCameraSensorRate(const std::string& sensorName,
+                                         const WindowID windowId,
+                                         const float rate) {
+  CameraSensorPtr_t sensor = getCameraSensor(sensorName, windowId);
+  ScopedLock lock(osgFrameMutex());
+  sensor->setRate(rate);
+  return true;
+}
+
+CameraSensorPtr_t WindowsManager::getCameraSensor(
+    const std::string& sensorName, const WindowID windowId) const {
+  WindowManagerPtr_t window = getWindowManager(windowId, true);
+  CameraSensorPtr_t sensor = window->getCameraSensor(sensorName);
+  if (!sensor)
+    throw std::invalid_argument("Window " + windowId + " has no sensor " +
+                                sensorName);
+  return sensor;
+}
+
 bool WindowsManager::addFloor(const std::string& floorName) {
   RETURN_FALSE_IF_NODE_EXISTS(floorName);
   LeafNodeGroundPtr_t floor = LeafNodeGround::create(floorName);
@@ -387,6 +499,14 @@ bool WindowsManager::addRod(const std::string& rodName, const Color_t& color,
   return true;
 }
 
+bool WindowsManager::applyRodConfiguration(const std::string& rodName,
+                                           const std::vector<float>& params) {
+  FIND_NODE_OF_TYPE_OR_THROW(NodeRod, rod, rodName);
+  ScopedLock lock(osgFrameMutex());
+  rod->applyConfiguration(params.empty() ? NULL : &params[0], params.size());
+  return true;
+}
+
 bool WindowsManager::resizeCapsule(const std::string& capsuleName,
                                    float newHeight) {
   FIND_NODE_OF_TYPE_OR_THROW(LeafNodeCapsule, cap, capsuleName);
@@ -405,6 +525,11 @@ bool WindowsManager::resizeArrow(const std::string& arrowName, float newRadius,
 
 bool WindowsManager::addMesh(const std::string& meshName,
                              const std::string& meshPath) {
+  return addMesh(meshName, meshPath, false);
+}
+
+bool WindowsManager::addMesh(const std::string& meshName,
+                             const std::string& meshPath, bool levelOfDetail) {
   RETURN_FALSE_IF_NODE_EXISTS(meshName);
   LeafNodeColladaPtr_t mesh;
   try {
@@ -413,6 +538,7 @@ bool WindowsManager::addMesh(const std::string& meshName,
     log() << exc.what() << std::endl;
     return false;
   }
+  if (levelOfDetail) mesh->setLevelOfDetail(true);
   ScopedLock lock(osgFrameMutex());
   addNode(meshName, mesh, true);
   return true;
@@ -563,6 +689,70 @@ bool WindowsManager::setCurveLineWidth(const std::string& curveName,
   return true;
 }
 
+bool WindowsManager::addTube(const std::string& tubeName,
+                             const std::vector<osgVector3>& points,
+                             const float radius, const Color_t& color) {
+  RETURN_FALSE_IF_NODE_EXISTS(tubeName);
+  LeafNodeTubePtr_t tube =
+      LeafNodeTube::create(tubeName, points, radius, color);
+  ScopedLock lock(osgFrameMutex());
+  addNode(tubeName, tube, true);
+  return true;
+}
+
+bool WindowsManager::setTubePoints(const std::string& tubeName,
+                                   const std::vector<osgVector3>& points) {
+  FIND_NODE_OF_TYPE_OR_THROW(LeafNodeTube, tube, tubeName);
+  ScopedLock lock(osgFrameMutex());
+  tube->setPoints(points);
+  return true;
+}
+
+bool WindowsManager::setTubeRadii(const std::string& tubeName,
+                                  const std::vector<float>& radii) {
+  FIND_NODE_OF_TYPE_OR_THROW(LeafNodeTube, tube, tubeName);
+  ScopedLock lock(osgFrameMutex());
+  tube->setRadii(radii);
+  return true;
+}
+
+bool WindowsManager::addMarkerArray(const std::string& markerArrayName,
+                                    const std::string& shape,
+                                    const Color_t& color) {
+  RETURN_FALSE_IF_NODE_EXISTS(markerArrayName);
+  LeafNodeMarkerArrayPtr_t markers = LeafNodeMarkerArray::create(
+      markerArrayName, markerShape(shape), color);
+  ScopedLock lock(osgFrameMutex());
+  addNode(markerArrayName, markers, true);
+  return true;
+}
+
+bool WindowsManager::setMarkerArrayPoses(
+    const std::string& markerArrayName,
+    const std::vector<Configuration>& poses) {
+  FIND_NODE_OF_TYPE_OR_THROW(LeafNodeMarkerArray, markers, markerArrayName);
+  ScopedLock lock(osgFrameMutex());
+  markers->setPoses(poses);
+  return true;
+}
+
+bool WindowsManager::setMarkerArrayScales(
+    const std::string& markerArrayName,
+    const std::vector<osgVector3>& scales) {
+  FIND_NODE_OF_TYPE_OR_THROW(LeafNodeMarkerArray, markers, markerArrayName);
+  ScopedLock lock(osgFrameMutex());
+  markers->setScales(scales);
+  return true;
+}
+
+bool WindowsManager::setMarkerArrayColors(
+    const std::string& markerArrayName, const std::vector<Color_t>& colors) {
+  FIND_NODE_OF_TYPE_OR_THROW(LeafNodeMarkerArray, markers, markerArrayName);
+  ScopedLock lock(osgFrameMutex());
+  markers->setColors(colors);
+  return true;
+}
+
 bool WindowsManager::addTriangleFace(const std::string& faceName,
                                      const osgVector3& pos1,
                                      const osgVector3& pos2,
@@ -659,8 +849,16 @@ bool WindowsManager::addNodeToRoadmap(const std::string& nameRoadmap,
 }
 
 std::vector<std::string> WindowsManager::getNodeList() {
+  return getNodeList("");
+}
+
+std::vector<std::string> WindowsManager::getNodeList(
+    const std::string& prefix) {
+  // The names are sorted, so the names with a prefix are contiguous.
   std::vector<std::string> l;
-  for (NodeMapIt it = nodes_.begin(); it != nodes_.end(); ++it) {
+  for (NodeMapIt it = nodes_.lower_bound(prefix);
+       it != nodes_.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+       ++it) {
     l.push_back(it->first);
   }
   return l;
@@ -668,12 +866,25 @@ std::vector<std::string> WindowsManager::getNodeList() {
 
 std::vector<std::string> WindowsManager::getGroupNodeList(
     const std::string& group) {
+  return getGroupNodeList(group, false);
+}
+
+std::vector<std::string> WindowsManager::getGroupNodeList(
+    const std::string& group, bool recursive) {
   std::vector<std::string> l;
   GroupNodePtr_t g(getGroup(group));
   if (!g) return l;
   l.reserve(g->getNumOfChildren());
   for (std::size_t i = 0; i < g->getNumOfChildren(); ++i)
     l.push_back(g->getChild(i)->getID());
+  if (!recursive) return l;
+  // The list grows while it is walked, breadth first.
+  for (std::size_t i = 0; i < l.size(); ++i) {
+    GroupNodeMapConstIt it = groupNodes_.find(l[i]);
+    if (it == groupNodes_.end()) continue;
+    for (std::size_t j = 0; j < it->second->getNumOfChildren(); ++j)
+      l.push_back(it->second->getChild(j)->getID());
+  }
   return l;
 }
 
@@ -775,6 +986,7 @@ bool WindowsManager::addToGroup(const std::string& nodeName,
   ScopedLock lock(osgFrameMutex());  // if addChild is called in the same time
                                      // as osg::frame(), gepetto-viewer crash
   groupNodes_[groupName]->addChild(nodes_[nodeName]);
+  parents_[nodeName].insert(groupName);
   return true;
 }
 
@@ -788,42 +1000,98 @@ bool WindowsManager::removeFromGroup(const std::string& nodeName,
   } else {
     ScopedLock lock(osgFrameMutex());
     groupNodes_[groupName]->removeChild(nodes_[nodeName]);
+    removeParent(nodeName, groupName);
     return true;
   }
 }
 
 bool WindowsManager::deleteNode(const std::string& nodeName, bool all) {
-  NodePtr_t n = getNode(nodeName);
-  if (!n)
-    return false;
-  else {
-    /// Check if it is a group
-    GroupNodeMapIt it = groupNodes_.find(nodeName);
-    if (it != groupNodes_.end()) {
-      if (all) {
-        std::vector<std::string> names(it->second->getNumOfChildren());
-        for (std::size_t i = 0; i < names.size(); ++i)
-          names[i] = it->second->getChild(i)->getID();
-        {
-          ScopedLock lock(osgFrameMutex());
-          it->second->removeAllChildren();
+  return deleteNodes(std::vector<std::string>(1, nodeName), all);
+}
+
+bool WindowsManager::deleteNodes(const std::vector<std::string>& nodeNames,
+                                 bool all) {
+  // The deleted nodes, parents before children.
+  std::vector<std::string> names;
+  std::set<std::string> deleted;
+  for (std::size_t i = 0; i < nodeNames.size(); ++i)
+    if (nodes_.find(nodeNames[i]) != nodes_.end() &&
+        deleted.insert(nodeNames[i]).second)
+      names.push_back(nodeNames[i]);
+  if (names.empty()) return false;
+  for (std::size_t i = 0; all && i < names.size(); ++i) {
+    GroupNodeMapConstIt it = groupNodes_.find(names[i]);
+    if (it == groupNodes_.end()) continue;
+    for (std::size_t j = 0; j < it->second->getNumOfChildren(); ++j) {
+      const std::string& child = it->second->getChild(j)->getID();
+      if (nodes_.find(child) != nodes_.end() && deleted.insert(child).second)
+        names.push_back(child);
+    }
+  }
+
+  std::vector<NodePtr_t> released;
+  released.reserve(names.size());
+  {
+    ScopedLock lock(osgFrameMutex());
+    // Detaching the deleted nodes from the kept groups is enough to remove
+    // them from the scene. The children of each group are removed at once.
+    std::map<GroupNodePtr_t, std::set<const Node*> > detached;
+    // The nodes attached to a window or with GroupNode::addChild are not in
+    // parents_. They are found by scanning the groups.
+    std::set<const Node*> unindexed;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      NodeMapIt it = nodes_.find(names[i]);
+      released.push_back(it->second);
+      ParentMapIt parents = parents_.find(names[i]);
+      std::size_t nParents = 0;
+      if (parents != parents_.end()) {
+        nParents = parents->second.size();
+        for (std::set<std::string>::const_iterator name =
+                 parents->second.begin();
+             name != parents->second.end(); ++name) {
+          if (deleted.count(*name) > 0) continue;
+          GroupNodeMapIt itg = groupNodes_.find(*name);
+          if (itg != groupNodes_.end())
+            detached[itg->second].insert(it->second.get());
         }
-        for (std::size_t i = 0; i < names.size(); ++i)
-          deleteNode(names[i], all);
+        parents_.erase(parents);
       }
-      {
-        ScopedLock lock(osgFrameMutex());
-        groupNodes_.erase(nodeName);
+      if (it->second->asGroup()->getNumParents() > nParents)
+        unindexed.insert(it->second.get());
+      GroupNodeMapIt itg = groupNodes_.find(names[i]);
+      if (itg != groupNodes_.end()) {
+        GroupNodePtr_t group = itg->second;
+        groupNodes_.erase(itg);
+        // The kept children are not in a registered group anymore.
+        for (std::size_t j = 0; !all && j < group->getNumOfChildren(); ++j)
+          removeParent(group->getChild(j)->getID(), names[i]);
       }
+      nodes_.erase(it);
     }
-    GroupNodeMapConstIt itg;
-    ScopedLock lock(osgFrameMutex());
-    for (itg = groupNodes_.begin(); itg != groupNodes_.end(); ++itg) {
-      if (itg->second && itg->second->hasChild(n)) itg->second->removeChild(n);
-    }
-    nodes_.erase(nodeName);
-    return true;
+    for (GroupNodeMapIt itg = groupNodes_.begin();
+         !unindexed.empty() && itg != groupNodes_.end(); ++itg)
+      for (std::size_t j = 0; j < itg->second->getNumOfChildren(); ++j) {
+        const Node* child = itg->second->getChild(j).get();
+        if (unindexed.count(child) > 0) detached[itg->second].insert(child);
+      }
+    for (std::map<GroupNodePtr_t, std::set<const Node*> >::iterator it =
+             detached.begin();
+         it != detached.end(); ++it)
+      it->first->removeChildren(it->second);
   }
+  nodesDeleted(names);
+  // The nodes are not part of the scene anymore, so they are destroyed
+  // without blocking the rendering nor the caller.
+  releaseNodes(released);
+  return true;
+}
+
+bool WindowsManager::clearGroup(const std::string& groupName) {
+  GroupNodePtr_t group = getGroup(groupName, true);
+  std::vector<std::string> names(group->getNumOfChildren());
+  for (std::size_t i = 0; i < names.size(); ++i)
+    names[i] = group->getChild(i)->getID();
+  return names.empty() || deleteNodes(names, true);
 }
 
 bool WindowsManager::removeObjectFromCache(const std::string& nodeName) {
@@ -1149,6 +1417,58 @@ void WindowsManager::setProperty(const std::string& nodeName,
   }
 }
 
+template <typename Property_t>
+void WindowsManager::setProperties(const std::vector<std::string>& nodeNames,
+                                   const std::vector<std::string>& propNames,
+                                   const std::vector<Property_t>& values) {
+  if (nodeNames.size() != values.size() ||
+      (propNames.size() != 1 && propNames.size() != nodeNames.size()))
+    throw std::invalid_argument(
+        "Number of node names, property names and values mismatch.");
+  if (nodeNames.empty()) return;
+
+  std::vector<Property*> modified;
+  modified.reserve(nodeNames.size());
+  std::string error;
+  {
+    ScopedLock lock(osgFrameMutex());
+    // Check all the properties before modifying any of them.
+    std::vector<NodePtr_t> nodes(nodeNames.size());
+    std::vector<Property*> props(nodeNames.size());
+    for (std::size_t i = 0; i < nodeNames.size(); ++i) {
+      nodes[i] = getNode(nodeNames[i], true);
+      props[i] = nodes[i]->property(propNames.size() == 1 ? propNames[0]
+                                                          : propNames[i]);
+      if (!props[i]->hasWriteAccess())
+        throw std::invalid_argument("Property " + props[i]->name() + " of " +
+                                    nodeNames[i] + " is read-only.");
+    }
+
+    // A setter may still fail, e.g. for a value out of range. The values
+    // applied before are kept and notified.
+    try {
+      for (std::size_t i = 0; i < nodeNames.size(); ++i) {
+        if (!props[i]->setWithoutNotification(Property_t(values[i])))
+          throw std::invalid_argument("Could not set the property of " +
+                                      nodeNames[i]);
+        // Consecutive updates of the same node only mark it dirty once.
+        if (i == 0 || nodes[i] != nodes[i - 1]) nodes[i]->setDirty();
+        modified.push_back(props[i]);
+      }
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+  }
+
+  // Notify the editors once per property, with the final value.
+  std::sort(modified.begin(), modified.end());
+  modified.erase(std::unique(modified.begin(), modified.end()),
+                 modified.end());
+  for (std::size_t i = 0; i < modified.size(); ++i)
+    modified[i]->notifyValueChanged();
+  if (!error.empty()) throw std::invalid_argument(error);
+}
+
 #define DEFINE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(Type, Name)    \
   Type WindowsManager::get##Name##Property(                             \
       const std::string& nodeName, const std::string& propName) const { \
@@ -1158,13 +1478,22 @@ void WindowsManager::setProperty(const std::string& nodeName,
                                            const std::string& propName, \
                                            const Type& value) {         \
     setProperty<Type>(nodeName, propName, value);                       \
+  }                                                                     \
+  void WindowsManager::set##Name##Properties(                           \
+      const std::vector<std::string>& nodeNames,                        \
+      const std::vector<std::string>& propNames,                        \
+      const std::vector<Type>& values) {                                \
+    setProperties<Type>(nodeNames, propNames, values);                  \
   }
 
 #define INSTANCIATE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(Type)          \
   template Type WindowsManager::getProperty<Type>(const std::string&,        \
                                                   const std::string&) const; \
   template void WindowsManager::setProperty<Type>(                           \
-      const std::string&, const std::string&, const Type&)
+      const std::string&, const std::string&, const Type&);                  \
+  template void WindowsManager::setProperties<Type>(                         \
+      const std::vector<std::string>&, const std::vector<std::string>&,      \
+      const std::vector<Type>&)
 
 INSTANCIATE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(std::string);
 INSTANCIATE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(osgVector2);
@@ -1182,6 +1511,39 @@ DEFINE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(float, Float)
 DEFINE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(bool, Bool)
 DEFINE_WINDOWS_MANAGER_GET_SET_PROPERTY_FOR_TYPE(int, Int)
 
+MemoryUsage WindowsManager::getNodeMemoryUsage(const std::string& nodeName) {
+  NodePtr_t node = getNode(nodeName, true);
+  MemoryUsageVisitor visitor;
+  ScopedLock lock(osgFrameMutex());
+  node->accept(visitor);
+  return visitor.usage(*node);
+}
+
+MemoryUsage WindowsManager::getWindowMemoryUsage(const WindowID windowId) {
+  WindowManagerPtr_t wm = getWindowManager(windowId, true);
+  MemoryUsageVisitor visitor;
+  ScopedLock lock(osgFrameMutex());
+  wm->accept(visitor);
+  return visitor.usage(*wm);
+}
+
+CullingStatistics WindowsManager::getCullingStatistics(
+    const WindowID windowId) {
+  WindowManagerPtr_t wm = getWindowManager(windowId, true);
+  ScopedLock lock(osgFrameMutex());
+  return wm->getCullingStatistics();
+}
+
+std::vector<RayHit> WindowsManager::castRays(
+    const std::string& nodeName, const std::vector<osgVector3>& origins,
+    const std::vector<osgVector3>& directions, const float maxDistance) {
+  NodePtr_t node = getNode(nodeName, true);
+  RayCaster caster;
+  caster.setMaxDistance(maxDistance);
+  ScopedLock lock(osgFrameMutex());
+  return caster.cast(node, origins, directions);
+}
+
 void WindowsManager::callVoidProperty(const std::string& nodeName,
                                       const std::string& propName) {
   NodePtr_t node = getNode(nodeName, true);
@@ -24,7 +24,22 @@
 #endif
 
 #include <gepetto/viewer/leaf-node-box.h>
+#include <gepetto/viewer/camera-sensor.h>
+#include <gepetto/viewer/frozen-geometry.h>
+#include <gepetto/viewer/group-node.h>
+#include <gepetto/viewer/leaf-node-capsule.h>
+#include <gepetto/viewer/leaf-node-marker-array.h>
+#include <gepetto/viewer/leaf-node-mesh.h>
+#include <gepetto/viewer/leaf-node-tube.h>
+#include <gepetto/viewer/memory-usage-visitor.h>
+#include <gepetto/viewer/node-rod.h>
 #include <gepetto/viewer/node.h>
+#include <gepetto/viewer/ray-caster.h>
+#include <gepetto/viewer/windows-manager.h>
+#include <OpenThreads/Thread>
+#include <osg/KdTree>
+#include <osgUtil/UpdateVisitor>
+#include <stdexcept>
 
 #define CHECK_VECT_CLOSE(a, b, tol) \
   BOOST_CHECK_SMALL((a - b).length2(), float(tol));
@@ -120,4 +135,345 @@ BOOST_AUTO_TEST_CASE(box) {
   NodeTest::checkAbstractClass(box);
 }
 
+BOOST_AUTO_TEST_CASE(unit_shapes) {
+  LeafNodeCapsulePtr_t capsule = LeafNodeCapsule::create("capsule", 0.1f, 1.f);
+  capsule->setDirty(false);
+  capsule->setRadius(0.2f);
+  BOOST_CHECK(capsule->isDirty());
+  BOOST_CHECK_EQUAL(capsule->getRadius(), 0.2f);
+  BOOST_CHECK_EQUAL(capsule->getHeight(), 1.f);
+
+  osgVector4 color(1.f, 0.f, 0.f, 0.5f);
+  capsule->setColor(color);
+  CHECK_VECT_CLOSE(capsule->getColor(), color, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(primitive_clone) {
+  LeafNodeCapsulePtr_t capsule = LeafNodeCapsule::create(
+      "capsule", 0.1f, 1.f, osgVector4(0.f, 0.f, 1.f, 1.f));
+  const unsigned int numChildren = capsule->asQueue()->getNumChildren();
+
+  LeafNodeCapsulePtr_t copy = LeafNodeCapsule::createCopy(capsule);
+  BOOST_CHECK(copy->hasProperty("Color"));
+  BOOST_CHECK_EQUAL(capsule->asQueue()->getNumChildren(), numChildren);
+  BOOST_CHECK_EQUAL(copy->asQueue()->getNumChildren(), numChildren);
+  CHECK_VECT_CLOSE(copy->getColor(), capsule->getColor(), 1e-6);
+
+  copy->setColor(osgVector4(1.f, 0.f, 0.f, 1.f));
+  copy->setRadius(0.2f);
+  BOOST_CHECK_EQUAL(capsule->getColor().r(), 0.f);
+  BOOST_CHECK_EQUAL(capsule->getRadius(), 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(lazy_subgraphs) {
+  LeafNodeBoxPtr_t box =
+      LeafNodeBox::create("box", osgVector3(0.1f, 0.2f, 0.3f));
+  std::size_t initial = box->getOverheadBytes();
+
+  box->setHighlightState(1);
+  BOOST_CHECK(box->getHighlightState() == 1);
+  std::size_t highlighted = box->getOverheadBytes();
+  BOOST_CHECK_GT(highlighted, initial);
+
+  box->setHighlightState(0);
+  box->setWireFrameMode(FILL_AND_WIREFRAME);
+  BOOST_CHECK_EQUAL(box->getWireFrameMode(), FILL_AND_WIREFRAME);
+  BOOST_CHECK_GT(box->getOverheadBytes(), highlighted);
+  // hl_switch_node_ptr_ is under both switch_node_ptr_ and the wireframe node
+  BOOST_CHECK_EQUAL(box->asGroup()->getNumChildren(), 2u);
+
+  box->setWireFrameMode(FILL);
+  BOOST_CHECK_EQUAL(box->asGroup()->getNumChildren(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage) {
+  GroupNodePtr_t group = GroupNode::create("group");
+  LeafNodeBoxPtr_t box =
+      LeafNodeBox::create("box", osgVector3(0.1f, 0.2f, 0.3f));
+  group->addChild(box);
+
+  MemoryUsageVisitor visitor;
+  group->accept(visitor);
+  const MemoryUsage& boxUsage = visitor.usage(*box);
+  const MemoryUsage& groupUsage = visitor.usage(*group);
+  BOOST_CHECK_GT(boxUsage.cpuBytes, box->getOverheadBytes());
+  BOOST_CHECK_EQUAL(boxUsage.subtreeCpuBytes, boxUsage.cpuBytes);
+  BOOST_CHECK_EQUAL(groupUsage.subtreeCpuBytes,
+                    groupUsage.cpuBytes + boxUsage.cpuBytes);
+  BOOST_CHECK_EQUAL(visitor.total().cpuBytes, groupUsage.subtreeCpuBytes);
+}
+
+BOOST_AUTO_TEST_CASE(group_children) {
+  GroupNodePtr_t group = GroupNode::create("group");
+  std::vector<LeafNodeBoxPtr_t> boxes;
+  for (int i = 0; i < 5; ++i) {
+    boxes.push_back(LeafNodeBox::create("box", osgVector3(1, 1, 1)));
+    group->addChild(boxes.back());
+  }
+  osg::ref_ptr<osg::Group> queue = group->getOsgNode()->asGroup();
+
+  BOOST_CHECK(group->removeChildren(1, 2));
+  BOOST_CHECK_EQUAL(group->getNumOfChildren(), 3u);
+  BOOST_CHECK(!group->hasChild(boxes[1]));
+  BOOST_CHECK(!queue->containsNode(boxes[2]->asGroup()));
+  BOOST_CHECK(group->getChild(1) == boxes[3]);
+  BOOST_CHECK(group->removeChild(boxes[4]));
+  BOOST_CHECK(!group->removeChild(boxes[4]));
+  BOOST_CHECK(group->hasChild(boxes[3]));
+  BOOST_CHECK(queue->containsNode(boxes[3]->asGroup()));
+  BOOST_CHECK(!group->removeChildren(2, 1));
+
+  // The last child takes the place of the removed one.
+  LeafNodeBoxPtr_t extra = LeafNodeBox::create("extra", osgVector3(1, 1, 1));
+  group->addChild(extra);
+  BOOST_CHECK(group->removeChild(boxes[0]));
+  BOOST_CHECK(group->getChild(0) == extra);
+  BOOST_CHECK(queue->getChild(0) == extra->asGroup().get());
+  BOOST_CHECK(!queue->containsNode(boxes[0]->asGroup()));
+  group->addChild(boxes[0]);
+  BOOST_CHECK(group->removeChild(extra));
+
+  std::set<const Node*> removed;
+  removed.insert(boxes[0].get());
+  removed.insert(boxes[3].get());
+  BOOST_CHECK(group->removeChildren(removed));
+  BOOST_CHECK_EQUAL(group->getNumOfChildren(), 0u);
+  BOOST_CHECK_EQUAL(queue->getNumChildren(), 0u);
+  BOOST_CHECK(!group->removeChildren(removed));
+
+  // Removing no child does not merge the geometries again.
+  group->addChild(boxes[1]);
+  group->setFrozen(true);
+  osg::ref_ptr<osg::Node> frozen = queue->getChild(0);
+  BOOST_CHECK(!group->removeChildren(removed));
+  BOOST_CHECK(queue->getChild(0) == frozen);
+}
+
+BOOST_AUTO_TEST_CASE(frozen_group) {
+  GroupNodePtr_t group = GroupNode::create("group");
+  LeafNodeBoxPtr_t box1 =
+      LeafNodeBox::create("box1", osgVector3(0.1f, 0.2f, 0.3f));
+  LeafNodeBoxPtr_t box2 =
+      LeafNodeBox::create("box2", osgVector3(0.1f, 0.2f, 0.3f));
+  box2->applyConfiguration(osgVector3(1.f, 0.f, 0.f), osgQuat());
+  group->addChild(box1);
+  group->addChild(box2);
+  osg::ref_ptr<osg::Group> queue = group->getOsgNode()->asGroup();
+
+  group->setFrozen(true);
+  BOOST_CHECK(group->getFrozen());
+  BOOST_CHECK(!queue->containsNode(box1->asGroup()));
+
+  const FrozenGeometry* frozen = NULL;
+  for (unsigned int i = 0; i < queue->getNumChildren(); ++i) {
+    osg::Geode* geode = queue->getChild(i)->asGeode();
+    if (geode != NULL && geode->getNumDrawables() > 0)
+      frozen = dynamic_cast<const FrozenGeometry*>(geode->getDrawable(0));
+  }
+  BOOST_REQUIRE(frozen != NULL);
+  BOOST_CHECK_EQUAL(frozen->nodeAtTriangle(0), "box1");
+  BOOST_CHECK_EQUAL(frozen->nodeAtVertex(0), "box1");
+  // Both boxes share the same state.
+  unsigned int last = frozen->getPrimitiveSet(0)->getNumIndices() / 3 - 1;
+  BOOST_CHECK_EQUAL(frozen->nodeAtTriangle(last), "box2");
+
+  group->setFrozen(false);
+  BOOST_CHECK(!group->getFrozen());
+  BOOST_CHECK(queue->containsNode(box1->asGroup()));
+  BOOST_CHECK(queue->containsNode(box2->asGroup()));
+}
+
+BOOST_AUTO_TEST_CASE(rod_tube) {
+  NodeRodPtr_t rod =
+      NodeRod::create("rod", osgVector4(1.f, 0.f, 0.f, 1.f), 0.1f, 2.f, 2);
+  std::vector<float> params(16, 0.f);
+  for (int i = 0; i < 2; ++i) {
+    params[8 * i] = 0.5f;         // length
+    params[8 * i + 1] = 1.f * i;  // x
+    params[8 * i + 4] = 1.f;      // qw
+  }
+  rod->applyConfiguration(&params[0], params.size());
+  BOOST_CHECK_EQUAL(rod->getCapsule(1)->getHeight(), 0.5f);
+  BOOST_CHECK_THROW(rod->applyConfiguration(&params[0], 10),
+                    std::invalid_argument);
+
+  rod->setTube(true);
+  BOOST_CHECK(rod->getTube());
+  osg::ref_ptr<osg::Group> queue = rod->getOsgNode()->asGroup();
+  BOOST_CHECK(!queue->containsNode(rod->getCapsule(0)->asGroup()));
+  // The tube spans from -0.35 to 1.35 along X.
+  BOOST_CHECK_CLOSE(queue->getBound().center().x(), 0.5f, 1e-3);
+
+  rod->setTube(false);
+  BOOST_CHECK(queue->containsNode(rod->getCapsule(0)->asGroup()));
+}
+
+BOOST_AUTO_TEST_CASE(tube) {
+  std::vector<osgVector3> points;
+  points.push_back(osgVector3(0.f, 0.f, 0.f));
+  points.push_back(osgVector3(1.f, 0.f, 0.f));
+  points.push_back(osgVector3(1.f, 1.f, 0.f));
+  LeafNodeTubePtr_t tube = LeafNodeTube::create(
+      "tube", points, 0.1f, osgVector4(1.f, 1.f, 1.f, 1.f));
+  BOOST_CHECK_THROW(tube->setPoints(std::vector<osgVector3>(1)),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(tube->setRadii(std::vector<float>(2, 0.2f)),
+                    std::invalid_argument);
+
+  std::vector<float> radii(3, 0.2f);
+  tube->setRadii(radii);
+  points[2].z() = 1.f;
+  tube->setPoints(points);
+  BOOST_CHECK_EQUAL(tube->getRadii().size(), 3u);
+  points.pop_back();
+  tube->setPoints(points);
+  BOOST_CHECK(tube->getRadii().empty());
+  BOOST_CHECK_CLOSE(tube->getOsgNode()->getBound().center().x(), 0.5f, 1e-3);
+
+  // The clone has its own color.
+  LeafNodeTubePtr_t copy = tube->clone();
+  BOOST_CHECK(copy->hasProperty("Color"));
+  copy->setColor(osgVector4(1.f, 0.f, 0.f, 1.f));
+  BOOST_CHECK_EQUAL(tube->getColor().g(), 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(marker_array) {
+  LeafNodeMarkerArrayPtr_t markers = LeafNodeMarkerArray::create(
+      "markers", LeafNodeMarkerArray::ARROW, osgVector4(1.f, 0.f, 0.f, 1.f));
+  BOOST_CHECK_EQUAL(markers->getNumMarkers(), 0u);
+
+  std::vector<Configuration> poses(3);
+  for (std::size_t i = 0; i < poses.size(); ++i)
+    poses[i].position = osgVector3((float)i, 0.f, 0.f);
+  markers->setPoses(poses);
+  BOOST_CHECK_EQUAL(markers->getNumMarkers(), 3u);
+  BOOST_CHECK_THROW(markers->setScales(std::vector<osgVector3>(2)),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(markers->setColors(std::vector<osgVector4>(4)),
+                    std::invalid_argument);
+  markers->setScales(std::vector<osgVector3>(3, osgVector3(1.f, 1.f, 1.f)));
+  BOOST_CHECK_CLOSE(markers->getOsgNode()->getBound().center().x(), 1.f,
+                    1e-3);
+
+  markers->setNumMarkers(1);
+  LeafNodeMarkerArrayPtr_t copy = markers->clone();
+  BOOST_CHECK_EQUAL(copy->getNumMarkers(), 1u);
+  BOOST_CHECK(copy->hasProperty("Color"));
+  copy->setColor(osgVector4(0.f, 1.f, 0.f, 1.f));
+  BOOST_CHECK_EQUAL(markers->getColor().r(), 1.f);
+  BOOST_CHECK_EQUAL(markers->getColor().g(), 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_kd_tree) {
+  LeafNodeMeshPtr_t mesh = LeafNodeMesh::create("mesh");
+  osg::Vec3ArrayRefPtr vertices = new osg::Vec3Array;
+  vertices->push_back(osgVector3(0.f, 0.f, 0.f));
+  vertices->push_back(osgVector3(1.f, 0.f, 0.f));
+  vertices->push_back(osgVector3(0.f, 1.f, 0.f));
+  osg::ref_ptr<osg::DrawElementsUInt> triangle =
+      new osg::DrawElementsUInt(GL_TRIANGLES);
+  triangle->push_back(0);
+  triangle->push_back(1);
+  triangle->push_back(2);
+  mesh->setVertexArray(vertices);
+  mesh->addPrimitiveSet(triangle);
+
+  // The KD-tree is built in the background from the next update traversal.
+  osg::Geometry* geom =
+      mesh->getOsgNode()->asGeode()->getDrawable(0)->asGeometry();
+  BOOST_CHECK(geom->getShape() == NULL);
+  osgUtil::UpdateVisitor update;
+  for (int i = 0; i < 1000 && geom->getShape() == NULL; ++i) {
+    mesh->getOsgNode()->accept(update);
+    OpenThreads::Thread::microSleep(1000);
+  }
+  BOOST_CHECK(dynamic_cast<osg::KdTree*>(geom->getShape()) != NULL);
+}
+
+BOOST_AUTO_TEST_CASE(ray_caster) {
+  GroupNodePtr_t scene = GroupNode::create("scene");
+  scene->addChild(LeafNodeBox::create("box", osgVector3(0.1f, 0.2f, 0.3f)));
+
+  // Enough rays to use several threads. Odd rays miss the box.
+  std::vector<osgVector3> origins, directions;
+  for (int i = 0; i < 500; ++i) {
+    origins.push_back(osgVector3(1.f, 0.f, (i % 2 == 0) ? 0.f : 1.f));
+    directions.push_back(osgVector3(-2.f, 0.f, 0.f));
+  }
+  RayCaster caster(4);
+  std::vector<RayHit> hits = caster.cast(scene, origins, directions);
+  BOOST_REQUIRE_EQUAL(hits.size(), origins.size());
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    if (i % 2 == 0) {
+      BOOST_REQUIRE(hits[i].hit());
+      BOOST_CHECK_CLOSE(hits[i].distance, 0.9f, 1e-3);
+      BOOST_CHECK_CLOSE(hits[i].normal.x(), 1.f, 1e-3);
+      BOOST_CHECK_EQUAL(hits[i].node, "box");
+    } else
+      BOOST_CHECK(!hits[i].hit());
+  }
+
+  caster.setMaxDistance(0.5f);
+  BOOST_CHECK(!caster.cast(scene, origins, directions)[0].hit());
+
+  directions.pop_back();
+  BOOST_CHECK_THROW(caster.cast(scene, origins, directions),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(camera_sensor) {
+  LeafNodeBoxPtr_t box = LeafNodeBox::create("box", osgVector3(1, 1, 1));
+  CameraSensorPtr_t sensor =
+      CameraSensor::create("sensor", box, 64, 48, 1.f, 0.1f, 10.f);
+  BOOST_CHECK_EQUAL(sensor->getColorImage()->s(), 64);
+  BOOST_CHECK_EQUAL(sensor->getColorImage()->t(), 48);
+  BOOST_CHECK_EQUAL(sensor->getPointImage()->getDataType(),
+                    (GLenum)GL_FLOAT);
+  BOOST_CHECK_EQUAL(sensor->getPointImage()->getTotalSizeInBytes(),
+                    64u * 48u * 4u * sizeof(float));
+
+  BOOST_CHECK_THROW(CameraSensor::create("s", box, 0, 48, 1.f, 0.1f, 10.f),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CameraSensor::create("s", box, 64, 48, 4.f, 0.1f, 10.f),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CameraSensor::create("s", box, 64, 48, 1.f, 1.f, 0.1f),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(node_names) {
+  WindowsManagerPtr_t wm = WindowsManager::create();
+  const osgVector4 red(1, 0, 0, 1);
+  wm->createGroup("robot");
+  wm->createGroup("robot/link");
+  wm->addBox("robot/link/box", 1, 1, 1, red);
+  wm->addBox("robot2", 1, 1, 1, red);
+  wm->createGroup("other");
+  wm->addToGroup("robot/link/box", "other");
+
+  std::vector<std::string> names = wm->getNodeList("robot/");
+  BOOST_REQUIRE_EQUAL(names.size(), 2u);
+  BOOST_CHECK_EQUAL(names[0], "robot/link");
+  BOOST_CHECK_EQUAL(names[1], "robot/link/box");
+  BOOST_CHECK_EQUAL(wm->getNodeList("robot").size(), 4u);
+  BOOST_CHECK_EQUAL(wm->getGroupNodeList("robot", false).size(), 1u);
+  BOOST_CHECK_EQUAL(wm->getGroupNodeList("robot", true).size(), 2u);
+
+  // The box is removed from all its parents.
+  BOOST_CHECK(wm->deleteNode("robot", true));
+  BOOST_CHECK(wm->getNodeList("robot/").empty());
+  BOOST_CHECK(wm->getGroupNodeList("other").empty());
+  BOOST_CHECK(wm->nodeExists("robot2"));
+
+  wm->addBox("other/box", 1, 1, 1, red);
+  BOOST_CHECK(wm->clearGroup("other"));
+  BOOST_CHECK(!wm->nodeExists("other/box"));
+  BOOST_CHECK(wm->getGroupNodeList("other").empty());
+  BOOST_CHECK(wm->nodeExists("other"));
+
+  // A child added without the windows manager is removed as well.
+  wm->getGroup("other")->addChild(wm->getNode("robot2"));
+  BOOST_CHECK(wm->deleteNode("robot2", false));
+  BOOST_CHECK_EQUAL(wm->getGroup("other")->getNumOfChildren(), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -72,9 +72,9 @@ BOOST_AUTO_TEST_CASE(pfloat1) {
   property.value = 0.;
 
   bool setWorked = false;
-  bool ok = QMetaObject::invokeMethod(&property, "set", Qt::DirectConnection,
-                                      Q_RETURN_ARG(bool, setWorked),
-                                      Q_ARG(float, 1.));
+  bool ok = QMetaObject::invokeMethod(
+      property.notifier(), "set", Qt::DirectConnection,
+      Q_RETURN_ARG(bool, setWorked), Q_ARG(float, 1.));
 
   BOOST_CHECK(ok);
   BOOST_CHECK(setWorked);
@@ -87,7 +87,7 @@ BOOST_AUTO_TEST_CASE(pfloat2) {
   PropertyTest* ptest = new PropertyTest;
   property->value = 0.;
 
-  ptest->connect(property.get(), SIGNAL(valueChanged(float)),
+  ptest->connect(property->notifier(), SIGNAL(valueChanged(float)),
                  SLOT(floatChanged(float)));
 
   property->set(1.);
@@ -96,6 +96,35 @@ BOOST_AUTO_TEST_CASE(pfloat2) {
   delete ptest;
 }
 
+BOOST_AUTO_TEST_CASE(pfloat_no_notifier) {
+  StoredPropertyTpl<float> property("float");
+  property.value = 0.;
+
+  BOOST_CHECK(property.set(1.f));
+  BOOST_CHECK(!property.hasNotifier());
+  BOOST_CHECK_EQUAL(property.value, 1.);
+}
+
+BOOST_AUTO_TEST_CASE(pfloat_notification) {
+  StoredPropertyTpl<float>::Ptr_t property(
+      new StoredPropertyTpl<float>("float"));
+  PropertyTest* ptest = new PropertyTest;
+  property->value = 0.;
+
+  ptest->connect(property->notifier(), SIGNAL(valueChanged(float)),
+                 SLOT(floatChanged(float)));
+
+  BOOST_CHECK(property->setWithoutNotification(1.f));
+  BOOST_CHECK(property->setWithoutNotification(2.f));
+  BOOST_CHECK(!ptest->called);
+  BOOST_CHECK_EQUAL(property->value, 2.);
+
+  property->notifyValueChanged();
+  BOOST_CHECK(ptest->called);
+  BOOST_CHECK_EQUAL(ptest->value, 2.);
+  delete ptest;
+}
+
 BOOST_AUTO_TEST_CASE(pfloat3) {
   int argc = 0;
   char** argv = NULL;
@@ -107,9 +136,9 @@ BOOST_AUTO_TEST_CASE(pfloat3) {
   PropertyTest* ptestd = new PropertyTest;
   property->value = 0.;
 
-  ptestf->connect(property.get(), SIGNAL(valueChanged(float)),
+  ptestf->connect(property->notifier(), SIGNAL(valueChanged(float)),
                   SLOT(floatChanged(float)), Qt::QueuedConnection);
-  ptestd->connect(property.get(), SIGNAL(valueChanged(double)),
+  ptestd->connect(property->notifier(), SIGNAL(valueChanged(double)),
                   SLOT(doubleChanged(double)), Qt::QueuedConnection);
 
   property->set(1.);
@@ -130,10 +159,10 @@ BOOST_AUTO_TEST_CASE(pfloat4) {
   property->value = 0.;
 
   PropertyTest* ptestf = new PropertyTest;
-  ptestf->connect(property.get(), SIGNAL(valueChanged(float)),
+  ptestf->connect(property->notifier(), SIGNAL(valueChanged(float)),
                   SLOT(floatChanged(float)), Qt::QueuedConnection);
-  property->connect(ptestf, SIGNAL(changeFloat(float)), SLOT(set(float)),
-                    Qt::QueuedConnection);
+  property->notifier()->connect(ptestf, SIGNAL(changeFloat(float)),
+                                SLOT(set(float)), Qt::QueuedConnection);
 
   ptestf->setFloat(1.);
   BOOST_CHECK(!ptestf->called);
@@ -146,10 +175,10 @@ BOOST_AUTO_TEST_CASE(pfloat4) {
   BOOST_CHECK(ptestf->called);
 
   PropertyTest* ptestd = new PropertyTest;
-  ptestd->connect(property.get(), SIGNAL(valueChanged(double)),
+  ptestd->connect(property->notifier(), SIGNAL(valueChanged(double)),
                   SLOT(doubleChanged(double)), Qt::QueuedConnection);
-  property->connect(ptestd, SIGNAL(changeDouble(double)), SLOT(set(double)),
-                    Qt::QueuedConnection);
+  property->notifier()->connect(ptestd, SIGNAL(changeDouble(double)),
+                                SLOT(set(double)), Qt::QueuedConnection);
 
   ptestd->setDouble(2.);
   BOOST_CHECK(!ptestd->called);